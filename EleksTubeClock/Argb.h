@@ -35,6 +35,7 @@ public:
         BlendInOut      = 0x20,         // blend time values to effect values & color, hold, blend effect values to time values & colors
         BlendOut        = 0x30,         // appear, blend out (used for sync code)
         Flash           = 0x40,         // HoldTime is number of flashes
+        Pulse           = 0x50,         // blend in, pulse while holding, blend out
     };
 };
 
@@ -14,9 +14,12 @@
 #include "WebServer.h"
 #include "WiFiAp.h"
 #include "NtpClient.h"
+#include "SettingsStore.h"
 #include "TimeZone.h"
+#include "FlightRecorder.h"
 #include "ResetButton.h"
 #include "SplashScreen.h"
+#include "FrameBench.h"
 #include "Columns.h"
 
 
@@ -34,6 +37,7 @@ Console::Cmd const      Console::g_cmds[] =
     "ntp",      "force ntp sync",               & Console::OnSyncNtp,
     "wcnt",     "WiFi.begin()",                 & Console::OnWiFiBegin,
     "splash",   "test for ficker",              & Console::OnTestForFlicker,
+    "bench",    "frame cost [frames]",          & Console::OnFrameBench,
     "reboot",   "reboot",                       & Console::OnReboot,
     "PReset",   "reset password",               & Console::OnPasswordReset,
     "FReset",   "factory reset",                & Console::OnFactoryReset,
@@ -147,7 +151,7 @@ Console::OnSetName()
             _buffer[ len + 1 ] = 0;
         }
         strncpy( g_options._prefixName, _buffer, sizeof(g_options._prefixName) );
-        g_options.Save();
+        g_options.SaveSoon();
     }
 }
 
@@ -158,8 +162,8 @@ Console::OnSetSsid()
     if ( strlen(_buffer) )
     {
         strncpy( g_options._ssid, _buffer, sizeof(g_options._ssid) );
-        g_options.Save();
-        system_restart();
+        g_options.SaveSoon();
+        Reboot();
     }
 }
 
@@ -223,10 +227,19 @@ Console::OnTestForFlicker()
 }
 
 
+void
+Console::OnFrameBench()
+{
+    const uint  frames  = atoi( _buffer );
+
+    FrameBench( frames ? frames : 120 );
+}
+
+
 void
 Console::OnReboot()
 {
-    system_restart();
+    Reboot();
 }
 
 
@@ -236,7 +249,7 @@ Console::OnPasswordReset()
     if ( g_options._password[0] )
     {
         g_options._password[ 0 ] = 0;
-        g_options.Save();
+        g_options.SaveSoon();
     }
 }
 
@@ -367,9 +380,8 @@ void
 Console::MiscStats( HtmlOut const & htmlOut )
 {
     uint            wifiStatus = WiFi.status();
-    Columns         out( 2, ". ", ':', htmlOut );
     char            digits[ NUM_DIGITS * 3 ];
-    char            version[ 8 ];
+    char            version[ 32 ];
 
     {
         StringBuffer    sbDigits(
@@ -388,40 +400,109 @@ Console::MiscStats( HtmlOut const & htmlOut )
         }
     }
 
-    sprintf( version, "1.%d", g_options._version );
-    for ( uint pass = 0; pass < 2; ++pass )
+    sprintf( version, "build %08x, settings %d", g_flightRecorder.BuildId(), SettingsStore::k_format );
     {
-        out.SetPass( pass );
+        Columns     out( 2, ". ", ':', htmlOut );
 
-        out.Row2( "Version",            version );
-        out.Row2( "Prefix",             g_options._prefixName );
-        out.Row2( "SSID",               g_options._ssid );
-        out.Row2( "Password",           g_options._password[0] ? "yes" : "no" );
-        out.Row2( "Time",               TimeStr() );
-        out.Row2( "Digits",             digits );
-        out.Row2( "IsDisplaying",       g_globalColor.IsDisplayingStr() );
-        out.Row2( "<RunTime",           Duration( g_poweredOnTime ) );
-        out.Row2( "Brightness",         g_brightness );
-        out.Row2( "Frames",             u64str( g_frameCount ) );
-        out.Row2( "Frames Off",         g_frameOff );
-        out.Row2( "Frames Lag",         g_framesLag );
-        out.Row2( "Web Requests",       g_wifiAp.Server().ResponsesSent() );
-        out.Row2( "WifiMode",           WiFiAp::WlMode2Str(WiFi.getMode()) );
-        out.Row2( "WifiStatus",         WiFiAp::WlStatus2Str(wifiStatus) );
-        if ( wifiStatus & WIFI_AP )
+        for ( uint pass = 0; pass < 2; ++pass )
         {
-            out.Row2( "Wifi.AP.ip",     WiFi.softAPIP().toString() );
+            out.SetPass( pass );
+
+            out.Row2( "Version",            version );
+            out.Row2( "Prefix",             g_options._prefixName );
+            out.Row2( "SSID",               g_options._ssid );
+            out.Row2( "Password",           g_options._password[0] ? "yes" : "no" );
+            out.Row2( "Time",               TimeStr() );
+            out.Row2( "Digits",             digits );
+            out.Row2( "IsDisplaying",       g_globalColor.IsDisplayingStr() );
+            out.Row2( "<RunTime",           Duration( g_poweredOnTime ) );
+            out.Row2( "Brightness",         g_brightness );
+            out.Row2( "Frames",             u64str( g_frameCount ) );
+            out.Row2( "Frames Off",         g_frameOff );
+            out.Row2( "Frames Same",        u64str( g_frameSame ) );
+            out.Row2( "Frames Lag",         g_framesLag );
+            out.Row2( "FPS",                g_fps );
+            out.Row2( "Idle %",             g_idlePercent );
+            out.Row2( "Web Requests",       g_wifiAp.Server().ResponsesSent() );
+            if ( g_wifiAp.Server().ResponsesSent() )
+            {
+                out.Row2( "Web min heap",   g_wifiAp.Server().MinFreeHeap() );
+            }
+            out.Row2( "WifiMode",           WiFiAp::WlMode2Str(WiFi.getMode()) );
+            out.Row2( "WifiStatus",         WiFiAp::WlStatus2Str(wifiStatus) );
+            if ( wifiStatus & WIFI_AP )
+            {
+                out.Row2( "Wifi.AP.ip",     WiFi.softAPIP().toString() );
+            }
+            if ( wifiStatus & WIFI_STA )
+            {
+                out.Row2( "Wifi.STA.ip",    WiFi.localIP().toString() );
+            }
+            out.Row2( "MAC address",        WiFi.macAddress() );
+            out.Row2( "NtpState",           g_ntp.GetStateStr() );
+            out.Row2( "<NtpSync",           g_ntp.LastSync() );
+            out.Row2( "NtpOffset ms",       String( g_ntp.LastOffset() ) );
+            out.Row2( "NtpDelay ms",        String( g_ntp.LastDelay() ) );
+            out.Row2( "NtpServers",         g_ntp.LastSelect() );
+            out.Row2( "TzState",            g_timeZone.GetStateStr() );
+            out.Row2( "GmtOffset",          g_options._gmtOffset );
+            out.Row2( "MicroAdjust ppb",    String( g_options._madjPpb ) );
+            out.Row2( "Slew",               SlewStr() );
+            out.Row2( "TimeToLock",         TimeToLock() );
+            out.Row2( "free_heap",          ESP.getFreeHeap() );
+            out.Row2( "Settings",           g_settings.toString() );
+            out.Row2( "Log",                LogStats() );
+            out.Row2( "Boot",               FlightRecorder::EventStr( g_flightRecorder.BootEvent() ) );
         }
-        if ( wifiStatus & WIFI_STA )
+    }
+
+    // time spent in each stage of a frame and each phase of loop()
+    TextOut( htmlOut, "Frame timing (us):\n" );
+    {
+        Columns     timing( 2, ". ", ':', htmlOut );
+
+        for ( uint pass = 0; pass < 2; ++pass )
         {
-            out.Row2( "Wifi.STA.ip",    WiFi.localIP().toString() );
+            timing.SetPass( pass );
+            for ( uint stage = 0; stage < FrameTimer::StageMax; ++stage )
+            {
+                Histogram const   & histogram = g_frameTimer.GetHistogram( FrameTimer::Stage(stage) );
+
+                if ( histogram.Count() )
+                {
+                    timing.Row2( FrameTimer::StageStr( FrameTimer::Stage(stage) ), histogram.toString() );
+                }
+            }
+
+            if ( g_wifiAp.Server().Latency().Count() )
+            {
+                timing.Row2( "WebRequest", g_wifiAp.Server().Latency().toString() );
+            }
+
+            if ( g_secondPhase.Count() )
+            {
+                timing.Row2( "SecondPhase", g_secondPhase.toString() );
+            }
         }
-        out.Row2( "MAC address",        WiFi.macAddress() );
-        out.Row2( "NtpState",           g_ntp.GetStateStr() );
-        out.Row2( "<NtpSync",           g_ntp.LastSync() );
-        out.Row2( "TzState",            g_timeZone.GetStateStr() );
-        out.Row2( "GmtOffset",          g_options._gmtOffset );
-     // out.Row2( ">MicroAdjust",       MadjSecondsPerDay( g_options._madjFreq * g_options._madjDir ).c_str() );
-        out.Row2( "free_heap",          ESP.getFreeHeap() );
     }
-}
\ No newline at end of file
+
+    // what led up to the last reset
+    if ( g_flightRecorder.Previous() )
+    {
+        TextOut( htmlOut, "Previous session (s since boot):\n" );
+        {
+            Columns     events( 2, ". ", ':', htmlOut );
+
+            for ( uint pass = 0; pass < 2; ++pass )
+            {
+                events.SetPass( pass );
+                for ( uint index = 0; index < g_flightRecorder.Previous(); ++index )
+                {
+                    FlightRecorder::Event const   & event = g_flightRecorder.PreviousEvent( index );
+
+                    events.Row2( FlightRecorder::EventTimeStr( event ).c_str(), FlightRecorder::EventStr( event ) );
+                }
+            }
+        }
+    }
+}
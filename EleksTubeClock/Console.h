@@ -43,6 +43,7 @@ private:
     void                OnSyncNtp();
     void                OnWiFiBegin();
     void                OnTestForFlicker();
+    void                OnFrameBench();
     void                OnReboot();
     void                OnPasswordReset();
     void                OnFactoryReset();
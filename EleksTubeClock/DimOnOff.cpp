@@ -9,6 +9,14 @@
 
 #include "platform.h"
 
+#define DIM_RAMP_MS     512             // to ramp across the whole brightness range
+
+
+// the ramp is kept here rather than next to _target, as Options saves the whole DimOnOff
+// as one field.  a bigger class would no longer match the saved size (or the v1 image's)
+static uint32   g_rampMs;               // g_ms the ramp was last advanced
+static uint16   g_rampLevel;            // g_brightness in 8.8 fixed point.  (keeps the fraction between frames)
+
 
 bool
 DimOnOff::IsDim() const
@@ -17,31 +25,49 @@ DimOnOff::IsDim() const
 }
 
 
+bool
+DimOnOff::IsRamping() const
+{
+    return ( _target != g_brightness );
+}
+
+
 void
 DimOnOff::Loop()
 {
     OnOff::DigitalRead( GPIO_FORCE_BRIGHT, GPIO_FORCE_DIM );
-    _target = OnOff::Loop() ? g_options._dim : g_options._bright;
+
+    const uint8     target  = OnOff::Loop() ? g_options._dim : g_options._bright;
+
+    // the ramp starts now.  (not at the last frame, which could be an idle frame ago)
+    if ( target != _target )
+    {
+        _target = target;
+        g_rampMs = g_ms;
+    }
 }
 
 
 void
 DimOnOff::NextFrame()
 {
+    const uint32    elapsed = MIN( g_ms - g_rampMs, uint32(DIM_RAMP_MS) );
+
+    g_rampMs = g_ms;
+    if ( (g_rampLevel >> 8) != g_brightness )
+    {
+        g_rampLevel = g_brightness << 8;
+    }
+
+    // by elapsed time, so the ramp takes as long at any frame rate
     if ( _target != g_brightness )
     {
-        int8 const  diff    = _target - g_brightness;
-        int8 const  step    = 8;
-        int8 const  delta   = ( diff < 0 ? -step : +step );
-
-        if ( ABS(diff) < step )
-        {
-            g_brightness = _target;
-        }
-        else
-        {
-            g_brightness += delta;
-        }
+        const int32     step    = ( elapsed * (255 << 8) ) / DIM_RAMP_MS;
+        const int32     target  = _target << 8;
+        const int32     level   = g_rampLevel;
+
+        g_rampLevel = ( target > level ) ? MIN( level + step, target ) : MAX( level - step, target );
+        g_brightness = g_rampLevel >> 8;
     }
 }
 
@@ -15,6 +15,7 @@ public:
     void        NextFrame();
 
     bool        IsDim() const;
+    bool        IsRamping() const;  // g_brightness is still moving to the target
 
 private:
     uint8       _target;            // the target brightness
@@ -11,7 +11,12 @@
 #include "platform.h"
 
 
-const uint8     EleksDigit::k_posMap[] = { 5, 0, 6, 1, 7, 2, 8, 3, 9, 4 };
+#define BRIGHTNESS_GAMMA    2.2
+#define HUE_CYCLE_MS        4267        // once around the rainbow.  (1 hue a frame at 60fps)
+
+const uint8     EleksDigit::k_posMap[ POSITIONS_PER_DIGIT ] = { 5, 0, 6, 1, 7, 2, 8, 3, 9, 4 };      // glyph -> led (of the first row)
+uint8           EleksDigit::s_lutBrightness;
+uint8           EleksDigit::s_lut[ 256 ];
 
 
 void
@@ -25,8 +30,8 @@ EleksDigit::Initialize( CRGB *leds, uint8 hue )
 void
 EleksDigit::ClearRGB()
 {
-    _SetColor( _value[ Time ], CRGB::Black );
-    _SetColor( _value[ Effect ], CRGB::Black );
+    _SetColor( _layers[ Time ]._value, CRGB::Black );
+    _SetColor( _layers[ Effect ]._value, CRGB::Black );
     _values = 0;
 }
 
@@ -37,7 +42,7 @@ EleksDigit::SetValue( ValueType index, uint value )
     if ( index <= Effect )
     {
         _values |= ( 1 << index );
-        _value[ index ] = value;
+        _layers[ index ]._value = value;
     }
 }
 
@@ -45,7 +50,7 @@ EleksDigit::SetValue( ValueType index, uint value )
 uint8
 EleksDigit::GetTimeValue() const
 {
-    return _value[ Time ];
+    return _layers[ Time ]._value;
 }
 
 
@@ -56,17 +61,34 @@ EleksDigit::GetTimeColor() const
 }
 
 
+bool
+EleksDigit::IsRainbow() const
+{
+    return _rainbow;
+}
+
+
 void
 EleksDigit::NextFrame( ARGB effectColor, ValueType show )
 {
-    _hue += 1;
-    _hueColor.setHue( _hue );
+    // by g_ms, so the rainbow turns at the same speed at any frame rate
+    const uint8     hue     = ( (g_ms % HUE_CYCLE_MS) << 8 ) / HUE_CYCLE_MS;
+
+    _hueColor.setHue( _hue + hue );
+
+    Layer         & time    = _layers[ Time ];
+    Layer         & effect  = _layers[ Effect ];
+
+    time._alpha = 0;
+    effect._alpha = 0;
 
     if ( !effectColor.alpha )
     {
         // no effect
-        _SetColorWithBrightness( _value[Time], _hueColor );
+        time._color = _hueColor;
+        time._alpha = 0xFF;
         _lastEffect = Time;
+        _rainbow = ( time._value < POSITIONS_PER_DIGIT );
     }
     else
     {
@@ -86,7 +108,7 @@ EleksDigit::NextFrame( ARGB effectColor, ValueType show )
             show = Time;
         }
 
-        if ( (show == Blend) && (_value[Time] == _value[Effect]) )
+        if ( (show == Blend) && (time._value == effect._value) )
         {
             show = Effect;
         }
@@ -94,19 +116,49 @@ EleksDigit::NextFrame( ARGB effectColor, ValueType show )
         _lastEffect = show;
         if ( show != Blend )
         {
-            rgb = blend( _hueColor, rgb, effectColor.alpha );
-            _SetColorWithBrightness( _value[ show ], rgb );
+            _layers[ show ]._color = blend( _hueColor, rgb, effectColor.alpha );
+            _layers[ show ]._alpha = 0xFF;
+            _rainbow = ( effectColor.alpha != 0xFF ) && ( _layers[ show ]._value < POSITIONS_PER_DIGIT );
         }
         else 
         {
-            nscale8x3( rgb.r, rgb.g, rgb.b, effectColor.alpha );
-            _SetColorWithBrightness( _value[ Effect ], rgb );
-        
-            rgb = _hueColor;
-            nscale8x3( rgb.r, rgb.g, rgb.b, 255-effectColor.alpha );
-            _SetColorWithBrightness( _value[ Time ], rgb );
+            effect._color = rgb;
+            effect._alpha = effectColor.alpha;
+            time._color = _hueColor;
+            time._alpha = 255 - effectColor.alpha;
+            _rainbow = ( time._value < POSITIONS_PER_DIGIT );
+        }
+    }
+
+    Compose();
+}
+
+
+// one pass over the digit's positions.  each layer adds its color scaled by its alpha
+void
+EleksDigit::Compose()
+{
+    CRGB        colors[ POSITIONS_PER_DIGIT ];
+
+    memset( colors, 0, sizeof(colors) );
+    for ( Layer const &layer : _layers )
+    {
+        if ( (layer._alpha) && (layer._value < POSITIONS_PER_DIGIT) )
+        {
+            CRGB    rgb = layer._color;
+
+            if ( layer._alpha != 0xFF )
+            {
+                nscale8x3( rgb.r, rgb.g, rgb.b, layer._alpha );
+            }
+            colors[ layer._value ] += rgb;
         }
     }
+
+    for ( uint value = 0; value < countof(colors); ++value )
+    {
+        _SetColor( value, colors[ value ] );
+    }
 }
 
 
@@ -121,35 +173,76 @@ EleksDigit::AppendDigit( StringBuffer *sb )
 
     if ( _lastEffect != Blend )
     {
-        add( _value[_lastEffect] );
+        add( _layers[ _lastEffect ]._value );
     }
     else
     {
         sb->Add( '[' );
-        add( _value[Time] );
-        add( _value[Effect] );
+        add( _layers[ Time ]._value );
+        add( _layers[ Effect ]._value );
         sb->Add( ']' );
     }
 }
 
 
+// The brightness is treated as perceived brightness (gamma corrected), so the dim
+// setting looks like the level the user picked.  The colors themselves are left
+// linear as FastLED's rainbow is already balanced for leds
+void
+EleksDigit::_BuildBrightnessLut( uint8 brightness )
+{
+    uint8   scale   = 0;
+
+    if ( brightness )
+    {
+        const int   perceived   = int( 255.0 * pow( brightness / 255.0, BRIGHTNESS_GAMMA ) + 0.5 );
+
+        scale = MAX( 1, perceived );
+    }
+
+    for ( uint value=0; value < countof(s_lut); ++value )
+    {
+        s_lut[ value ] = scale8_video( value, scale );
+    }
+
+    s_lutBrightness = brightness;
+}
+
+
+// one pass over the frame.  called after every digit has rendered
 void
-EleksDigit::_SetColorWithBrightness( uint8 value, CRGB color )
+EleksDigit::ApplyBrightness( CRGB *leds, uint count )
 {
-    nscale8x3( color.r, color.g, color.b, g_brightness );
-    _SetColor( value, color );
+    if ( g_brightness != 0xFF )
+    {
+        uint8         * p       = &leds[ 0 ].raw[ 0 ];
+        uint8 * const   end     = p + count * sizeof( CRGB );
+
+        if ( g_brightness != s_lutBrightness )
+        {
+            _BuildBrightnessLut( g_brightness );
+        }
+
+        for ( ; p < end; ++p )
+        {
+            *p = s_lut[ *p ];
+        }
+    }
 }
 
 
 void
 EleksDigit::_SetColor( uint8 value, CRGB color )
 {
-    if ( value < 10 )
+    if ( value < POSITIONS_PER_DIGIT )
     {
         const int     index   = k_posMap[ value ];
 
-        _leds[ index ] = color;
-        _leds[ index+10 ] = color;
+        // (a constant count.  the compiler unrolls it)
+        for ( uint led = 0; led < LEDS_PER_POSITION; ++led )
+        {
+            _leds[ index + led * POSITIONS_PER_DIGIT ] = color;
+        }
     }
 }
 
@@ -1,6 +1,8 @@
 /*
  * EleksDigit.h
  *  1 per digit on the ElkesTube clock
+ *  Each value type is a layer (a value, color and alpha).  NextFrame() sets the layers from
+ *  the effect and Compose() flattens them into the digit's leds.
  *
  * Author: Ken Reneris <https://github.com/KenReneris>
  * MIT License
@@ -28,24 +30,42 @@ public:
     bool        SetValue( ValueType index, uint value );
     uint8       GetTimeValue() const;
     ARGB        GetTimeColor() const;
+    bool        IsRainbow() const;              // the rainbow shows in this frame (so it changes every frame)
     void        AppendDigit( StringBuffer *sb );
 
+    static void ApplyBrightness( CRGB *leds, uint count );     // scale the rendered frame by g_brightness
+
 private:
-    void        _SetColorWithBrightness( uint8 value, CRGB color );
+    struct Layer
+    {
+        CRGB        _color;
+        uint8       _value;             // if the value > 9, then the layer is not displayed
+        uint8       _alpha;             // 0 skips the layer
+    };
+
+    static const uint   k_layers = Effect + 1;      // a layer per value (Time, Effect)
+
+private:
+    void        Compose();
     void        _SetColor( uint8 value, CRGB color );
 
+    static void _BuildBrightnessLut( uint8 brightness );
+
     friend class SplashScreen;
 
 private:
-    static const uint8  k_posMap[];
+    static const uint8  k_posMap[ POSITIONS_PER_DIGIT ];
+    static uint8        s_lutBrightness;            // g_brightness that s_lut was built for
+    static uint8        s_lut[ 256 ];               // led value -> value at s_lutBrightness
 
 private:
-    CRGB      * _leds;                  // our 0 to 9 leds.  Note there are 2 leds per digit.  So this is 20 leds
-    uint8       _value[ Effect+1 ];     // two values (for cross fade). [0]=time value. [1]=effect value. if the value > 9, then the digit is not displayed
+    CRGB      * _leds;                  // our LEDS_PER_DIGIT leds.  LEDS_PER_POSITION rows of POSITIONS_PER_DIGIT
+    Layer       _layers[ k_layers ];    // [Time] time value, [Effect] effect value (for cross fade)
     uint8       _values;                // bitmask of which _values have been set this frame.  
     ValueType   _lastEffect;            // debugging
 
     // rainbow effect
-    uint8       _hue;                   // udpated every frame to given rainbow effect
+    uint8       _hue;                   // this digit's offset in the rainbow effect
     CRGB        _hueColor;              // color for _hue
+    bool        _rainbow;               // a lit layer's color has _hueColor in it
 };
@@ -17,6 +17,9 @@
 #include "NtpClient.h"
 #include "TimeZone.h"
 #include "Console.h"
+#include "SettingsStore.h"
+#include "FlightRecorder.h"
+#include "Uart1Leds.h"
 
 
 enum class UpdateType
@@ -26,17 +29,22 @@ enum class UpdateType
     TimeZone,
     OnOff,
     Dim,
+    Settings,
     End,
 };
 
 
-#define NUM_LEDS            ( NUM_DIGITS * 20 )
-#define APPROX_FPS          60
-#define MS_PER_FRAME        (1000 / APPROX_FPS)  
-
 // misc globals
 EleksDigit          g_digits[ NUM_DIGITS ];         // Digits of the elekstube display
 static CRGB         g_leds[ NUM_LEDS ];             // Fastled array
+static CRGB         g_shownLeds[ NUM_LEDS ];        // g_leds as of the last FastLED.show()
+static uint32       g_lastShown;                    // g_ms of the last FastLED.show()
+static bool         g_secondFrame;                  // this frame changed the second (measure its phase)
+static uint32       g_frameMs;                      // current frame interval. MS_PER_FRAME or MS_PER_IDLE_FRAME
+static uint32       g_lastService;                  // g_ms of the last console/wifi service
+static uint32       g_statsStart;                   // g_ms of the start of the fps/idle window
+static uint32       g_statsFrames;                  // frames in the current fps/idle window
+static uint32       g_statsIdleMs;                  // ms slept in the current fps/idle window
 static uint8        g_showLeds;                     // stop calling fastled.show() when off
 static time_t       g_lastTime;                     // to notice when the time changes
 static uint32       g_lastFrame;                    // to notice if there's been lag
@@ -44,7 +52,11 @@ bool                g_wifiIsConnected;              // global of last wifi conne
 uint8               g_brightness;                   // the current brightness to display at. 0..255
 uint64              g_frameCount;                   // # of frame events
 uint64              g_frameOff;                     // # of frame events where the leds where off and not updated
+uint64              g_frameSame;                    // # of frame events where the leds didn't change and were not updated
 uint32              g_framesLag;                    // # of times there was some sort of lag
+uint32              g_fps;                          // effective frames per second
+uint32              g_idlePercent;                  // % of time spent sleeping
+Histogram           g_secondPhase;                  // us from the gmt second to the digits being shown
 static UpdateType   g_update;                       // extra compute (in shadow of led update).  round-robin polling 
 static Console      g_console;                      // global instance of console 
 Options             g_options;                      // global instance of user settings
@@ -52,6 +64,7 @@ WiFiAp              g_wifiAp;                       // global instance of soft A
 NtpClient           g_ntp;                          // global instance of ntp client time sync
 TimeZone            g_timeZone;                     // global instance of timezone time sync
 GlobalColor         g_globalColor;                  // global instance of global color state
+FrameTimer          g_frameTimer;                   // global instance of per-stage frame timing
 ResetButton         g_resetButton;                  // global instance of reset button handler
 
 static char         g_popup[ NUM_DIGITS ];          // (1 set of) values for a popup 
@@ -64,24 +77,39 @@ setup()
     Serial.begin( 115200 );
     ets_install_putc1( (void *) &OutC );
     Out( "\n\n\nEleksTube: Initialize (setup)\n" );
+    g_flightRecorder.Setup();
 
-    pinMode( BUILTIN_LED, OUTPUT );
+    if ( STATUS_LED )
+    {
+        pinMode( STATUS_LED, OUTPUT );
+    }
     pinMode( FLASH_BUTTON_PIN, INPUT );
     PinModePullUp( GPIO_FORCE_TIMEON );
     PinModePullUp( GPIO_FORCE_TIMEOFF );
     PinModePullUp( GPIO_FORCE_BRIGHT );
     PinModePullUp( GPIO_FORCE_DIM );
 
-    FastLED.addLeds<NEOPIXEL, NEOLED_PIN>( g_leds, countof(g_leds) );
+#if LED_UART1
+#if NEOLED_PIN2
+#error "LED_UART1 drives one strip.  (NEOLED_PIN2 must be 0)"
+#endif
+    FastLED.addLeds( &g_uart1Leds, g_leds, NUM_LEDS );
+#else
+    FastLED.addLeds<NEOPIXEL, NEOLED_PIN>( g_leds, STRIP1_LEDS );
+#if NEOLED_PIN2
+    FastLED.addLeds<NEOPIXEL, NEOLED_PIN2>( g_leds + STRIP1_LEDS, NUM_LEDS - STRIP1_LEDS );
+#endif
+#endif
 
     for ( int pos = 0; pos < countof(g_digits); ++pos )
     {
-        g_digits[ pos ].Initialize( &g_leds[pos * 20], (255/countof(g_digits)) * pos );
+        g_digits[ pos ].Initialize( &g_leds[pos * LEDS_PER_DIGIT], (255/countof(g_digits)) * pos );
     }
 
     g_update = UpdateType::Start;
     g_options.Setup();
     g_options.Load();
+    LoadDiscipline();
 
     if ( g_options._splashScreen )
     {
@@ -92,6 +120,9 @@ setup()
     g_ntp.Setup();
     g_timeZone.Setup();
     g_lastFrame = millis();
+    g_lastService = g_lastFrame;
+    g_statsStart = g_lastFrame;
+    g_frameMs = MS_PER_FRAME;
     g_brightness = g_options._bright;
     Log( "\n" );
 }
@@ -124,60 +155,192 @@ OutStr( char const *str )
 void
 loop()
 {
+    g_frameTimer.Start();
     UpdateTime();
 
-    if ( g_ms - g_lastFrame >= MS_PER_FRAME )
+    // frame when the interval is up, or right away when the second changes (as the
+    // idle interval is too slow to catch the digits changing).  if the second is about
+    // to change, skip the regular frame so it doesn't delay the one on the boundary
+    const uint32    toSecond = MsToNextSecond();
+    const bool      frameDue = ( g_ms - g_lastFrame >= g_frameMs ) && ( toSecond > SECOND_GUARD_MS );
+
+    if ( (frameDue) || (g_now != g_lastTime) )
     {
-        // advance smmoothly
-        g_lastFrame += MS_PER_FRAME;
-        
-        // missed frames?
-        if ( g_lastFrame < g_ms )
+        if ( frameDue )
         {
-            g_lastFrame = g_ms;
-            if ( g_showLeds )
+            // advance smmoothly
+            g_lastFrame += g_frameMs;
+            
+            // missed frames?
+            if ( g_lastFrame < g_ms )
             {
-                g_framesLag += 1;
+                if ( g_showLeds )
+                {
+                    g_framesLag += 1;
+                    g_flightRecorder.FrameLag( g_ms - g_lastFrame );
+                }
+                g_lastFrame = g_ms;
             }
         }
+        else
+        {
+            g_lastFrame = g_ms;
+        }
         
         NextFrame();
+        g_statsFrames += 1;
+        g_frameMs = IsFrameStatic() ? MS_PER_IDLE_FRAME : MS_PER_FRAME;
         yield();
         
+        g_frameTimer.Start();
         g_update = UpdateType( int(g_update) + 1 );
         switch ( g_update )
         {
         case UpdateType::Ntp:
             g_ntp.Loop();
+            g_frameTimer.Mark( FrameTimer::NtpLoop );
             break;
         
         case UpdateType::TimeZone:
             g_timeZone.Loop();
+            g_frameTimer.Mark( FrameTimer::TimeZoneLoop );
             break;
         
         case UpdateType::OnOff:
             g_options._timeOnOff.Loop();
             g_resetButton.Loop( !digitalRead(FLASH_BUTTON_PIN) );
+            g_frameTimer.Mark( FrameTimer::OnOffLoop );
             break;
 
         case UpdateType::Dim:
             g_options._dimOnOff.Loop();
+            g_frameTimer.Mark( FrameTimer::DimLoop );
+            break;
+
+        case UpdateType::Settings:
+            g_options.Loop();
+            g_settings.Loop( DisplayIsIdle() );
+            g_frameTimer.Mark( FrameTimer::SettingsLoop );
             break;
 
         case UpdateType::End:
             g_update = UpdateType::Start;
             break;
         }
+    }
 
+    // the console and webserver are serviced at the full frame rate even when the frames slow down.
+    // but not right before a second boundary (a web request can take a while)
+    if ( (g_ms - g_lastService >= MS_PER_FRAME) && (toSecond > SECOND_GUARD_MS) )
+    {
+        g_lastService = g_ms;
+        g_frameTimer.Start();
+        LogDrain();
         g_console.Loop();
+        g_frameTimer.Mark( FrameTimer::ConsoleLoop );
         g_wifiAp.Loop();
+        g_frameTimer.Mark( FrameTimer::WiFiLoop );
     }
 
-    // scan faster when expect responses
+    // scan faster during a burst (a reply is polled for, and the next request goes out as soon as it's seen)
     if ( g_ntp.GetState() == NtpClient::WaitingForResponse )
     {
+        g_frameTimer.Start();
         g_ntp.Loop();
+        g_frameTimer.Mark( FrameTimer::NtpPoll );
+    }
+
+    // keep the timezone http requests moving
+    if ( g_timeZone.GetState() == TimeZone::SyncingTimeZone )
+    {
+        g_frameTimer.Start();
+        g_timeZone.Loop();
+        g_frameTimer.Mark( FrameTimer::TimeZoneLoop );
     }
+
+    IdleSleep( toSecond );
+}
+
+
+// decided from what is being shown, not by comparing frames.  a slow rainbow or a dark
+// brightness ramp can render the same frame twice and still be moving
+bool
+IsFrameStatic()
+{
+    // a global effect has its own timing (ramps, flashes) unless it's holding.  e.g., the time turned off
+    if ( g_globalColor.IsAnimating() )
+    {
+        return false;
+    }
+
+    if ( g_options._dimOnOff.IsRamping() )
+    {
+        return false;
+    }
+
+    // the rainbow turns by g_ms.  it moves less than a hue a frame, so some frames repeat the last one
+    if ( g_brightness )
+    {
+        for ( EleksDigit const &digit : g_digits )
+        {
+            if ( digit.IsRainbow() )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+void
+IdleSleep( uint32 toSecond )
+{
+    uint32  wait;
+    uint32  start;
+
+    // when the display is static, delay() until the next service time (or second boundary).  this lets the sdk light sleep
+    if ( (g_frameMs != MS_PER_FRAME) &&
+         (!g_ntp.IsAwaiting()) &&
+         (g_timeZone.GetState() != TimeZone::SyncingTimeZone) )
+    {
+        wait = MS_PER_FRAME - MIN( uint32(millis() - g_lastService), uint32(MS_PER_FRAME) );
+        wait = MIN( wait, toSecond );
+        if ( wait )
+        {
+            start = millis();
+            delay( wait );
+            g_statsIdleMs += millis() - start;
+        }
+    }
+
+    // once a second, update the effective fps & idle share
+    if ( millis() - g_statsStart >= 1000 )
+    {
+        uint32 elapsed = millis() - g_statsStart;
+
+        g_fps = ( g_statsFrames * 1000 + elapsed / 2 ) / elapsed;
+        g_idlePercent = ( g_statsIdleMs * 100 ) / elapsed;
+        g_statsStart += elapsed;
+        g_statsFrames = 0;
+        g_statsIdleMs = 0;
+    }
+}
+
+
+bool
+DisplayIsIdle()
+{
+    return ( g_frameMs != MS_PER_FRAME );
+}
+
+
+void
+Reboot()
+{
+    g_options.Flush();
+    system_restart();
 }
 
 
@@ -194,8 +357,7 @@ UpdateWaitTimes()
 
         if ( !g_options._madjEnable )
         {
-            g_options._madjFreq = 0;
-            g_options._madjSmooth.Reset();
+            g_options._madjPpb = 0;
         }
     }
 }
@@ -221,7 +383,11 @@ NextFrame()
     if ( g_now != g_lastTime )
     {
         g_lastTime = g_now;
-        digitalWrite( BUILTIN_LED, LOW );
+        g_secondFrame = true;
+        if ( STATUS_LED )
+        {
+            digitalWrite( STATUS_LED, LOW );
+        }
 
         if ( !tm.Second )
         {
@@ -242,6 +408,7 @@ NextFrame()
 
         SetDigitsXXXXXX( EleksDigit::Time, HourMode(tm.Hour), tm.Minute, tm.Second );
     }
+    g_frameTimer.Mark( FrameTimer::Time );
 
     // set the value for the effect
     switch( g_globalColor.IsDisplaying() )
@@ -256,7 +423,8 @@ NextFrame()
 
     case GlobalColor::Date:
         tm.Year -= 30;
-        if ( g_options._dateMmddyy )
+        // (4 digits have no room for the year, so they always show mm dd)
+        if ( (g_options._dateMmddyy) || (NUM_DIGITS < 6) )
         {
             SetDigitsXXXXXX( EleksDigit::Effect, tm.Month, tm.Day, tm.Year );
         }
@@ -284,6 +452,7 @@ NextFrame()
         }
         g_globalColor.NextFrame();
     }
+    g_frameTimer.Mark( FrameTimer::State );
 
     for ( int pos = 0; pos < countof( g_digits ); ++pos )
     {
@@ -291,7 +460,11 @@ NextFrame()
     }
 
     g_options._dimOnOff.NextFrame();
+    EleksDigit::ApplyBrightness( g_leds, countof(g_leds) );
+    g_frameTimer.Mark( FrameTimer::Digits );
+
     ShowLeds();
+    g_frameTimer.Mark( FrameTimer::Show );
 }
 
 
@@ -378,9 +551,7 @@ SetDigitsTimer( uint32 time )
     int     minutes     = ( time - hours*60*60 ) / 60;
     int     seconds     = ( time - hours*60*60 - minutes*60 );
 
-    SetDigitsXX( EleksDigit::Time, &g_digits[0], hours );
-    SetDigitsXX( EleksDigit::Time, &g_digits[2], minutes );
-    SetDigitsXX( EleksDigit::Time, &g_digits[4], seconds );
+    SetDigitsXXXXXX( EleksDigit::Time, hours, minutes, seconds );
 
     for ( int index = 0; (index < NUM_DIGITS) && (!g_digits[index].GetTimeValue()); ++index )
     {
@@ -400,12 +571,26 @@ SetDigitsXX( EleksDigit::ValueType index, EleksDigit *digit, int value )
 }
 
 
+// as many of the pairs as there are digits for.  any digits past the pairs are blank
 void
 SetDigitsXXXXXX( EleksDigit::ValueType index, int x01, int x23, int x45 )
 {
-    SetDigitsXX( index, &g_digits[0], x01 );
-    SetDigitsXX( index, &g_digits[2], x23 );
-    SetDigitsXX( index, &g_digits[4], x45 );
+    static_assert( (NUM_DIGITS % 2) == 0, "the digits are set in pairs" );
+
+    const int   pairs[] = { x01, x23, x45 };
+
+    for ( int pos = 0; pos < NUM_DIGITS; pos += 2 )
+    {
+        if ( pos / 2 < countof(pairs) )
+        {
+            SetDigitsXX( index, &g_digits[pos], pairs[ pos / 2 ] );
+        }
+        else
+        {
+            g_digits[ pos ].SetValue( index, 10 );
+            g_digits[ pos + 1 ].SetValue( index, 10 );
+        }
+    }
 
     if ( (g_options._surpressLeadingZero) && (x01 < 10) )
     {
@@ -427,12 +612,32 @@ ShowLeds()
     if ( g_showLeds )
     {
         g_showLeds -= 1;
-        FastLED.show();
+
+        // skip the show (interrupts disabled, unless LED_UART1) if nothing changed.  but refresh every second regardless
+        if ( (memcmp( g_leds, g_shownLeds, sizeof(g_leds) )) || (g_ms - g_lastShown >= 1000) )
+        {
+            FastLED.show();
+            memcpy( g_shownLeds, g_leds, sizeof(g_leds) );
+            g_lastShown = g_ms;
+
+            if ( g_secondFrame )
+            {
+                g_secondPhase.Push( GmtUsIntoSecond() );
+            }
+        }
+        else
+        {
+            g_frameSame += 1;
+        }
     }
     else
     {
         g_frameOff += 1;
     }
 
-    digitalWrite( BUILTIN_LED, HIGH );
+    g_secondFrame = false;
+    if ( STATUS_LED )
+    {
+        digitalWrite( STATUS_LED, HIGH );
+    }
 }
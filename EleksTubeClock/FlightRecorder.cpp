@@ -0,0 +1,315 @@
+/*
+ * FlightRecorder
+ *  Ring of events in RTC user memory.
+ *
+ *  Memory:     Header, then k_events Events.  The ring restarts each session (after the
+ *              previous session's events are copied out)
+ *
+ *  RTC user memory keeps its contents over every reset but power on (and deep sleep
+ *  wake up), so the header's magic is what tells a recorded session from garbage.
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+#include "platform.h"
+#include <WiFiUdp.h>
+#include "NtpClient.h"
+#include "TimeZone.h"
+#include "FlightRecorder.h"
+
+#define FLIGHT_MAGIC            0x32524C46      // "FLR2"
+#define FRAME_LAG_COALESCE_MS   1000            // lags this close to the last one are counted in the same event
+#define EVENT_BLOCKS            ( sizeof(Event) / 4 )
+#define EVENT_OFFSET(i)         ( k_offset + (sizeof(Header) / 4) + ((i) * EVENT_BLOCKS) )
+
+
+class EspRtcMemory : public FlightMemory
+{
+public:
+    bool
+    Read( uint32 offset, uint32 *data, uint32 size ) override
+    {
+        return ESP.rtcUserMemoryRead( offset, data, size );
+    }
+
+    bool
+    Write( uint32 offset, uint32 const *data, uint32 size ) override
+    {
+        return ESP.rtcUserMemoryWrite( offset, const_cast<uint32 *>( data ), size );
+    }
+};
+
+
+static EspRtcMemory     g_espRtcMemory;
+FlightRecorder          g_flightRecorder( g_espRtcMemory );
+
+
+FlightRecorder::FlightRecorder( FlightMemory &memory )
+    : _memory       ( memory )
+    , _ready        ( false )
+    , _previous     ( 0 )
+{
+    memset( &_header, 0, sizeof(_header) );
+    memset( &_last, 0, sizeof(_last) );
+    memset( &_boot, 0, sizeof(_boot) );
+}
+
+
+void
+FlightRecorder::Setup()
+{
+    rst_info const    * info    = ESP.getResetInfoPtr();
+    char                md5[ 9 ];
+
+    // the build is the first 32 bits of the sketch's md5
+    strncpy( md5, ESP.getSketchMD5().c_str(), 8 );
+    md5[ 8 ] = 0;
+
+    const uint32        buildId = strtoul( md5, nullptr, 16 );
+
+    Start( buildId, info->reason, info->exccause, info->epc1, info->excvaddr );
+}
+
+
+void
+FlightRecorder::Start( uint32 buildId, uint32 reason, uint32 exccause, uint32 epc1, uint32 excvaddr )
+{
+    Header      previous;
+
+    static_assert( sizeof(Event) == 32, "Event is 8 blocks" );
+    static_assert( (k_offset * 4) + sizeof(Header) + (k_events * sizeof(Event)) <= 512, "RTC user memory is 512 bytes" );
+
+    // copy out the previous session.  (oldest first)
+    _previous = 0;
+    if ( (_memory.Read( k_offset, (uint32 *) &previous, sizeof(previous) )) &&
+         (previous._magic == FLIGHT_MAGIC) &&
+         (previous._buildId == buildId) )
+    {
+        const uint      count   = MIN( previous._count, k_events );
+        const uint      first   = previous._count - count;
+
+        for ( uint index = 0; index < count; ++index )
+        {
+            if ( _memory.Read( EVENT_OFFSET( (first + index) % k_events ), (uint32 *) &_previousEvents[ _previous ], sizeof(Event) ) )
+            {
+                _previous += 1;
+            }
+        }
+
+        _header._boots = previous._boots;
+    }
+
+    // new session
+    _header._magic = FLIGHT_MAGIC;
+    _header._buildId = buildId;
+    _header._count = 0;
+    _header._boots += 1;
+    _ready = true;
+
+    memset( &_boot, 0, sizeof(_boot) );
+    _boot._ms = g_ms;
+    _boot._kind = Kind::Boot;
+    _boot._value = reason;
+    _boot._extra = exccause;
+    _boot._data = epc1;
+    _boot._data2 = excvaddr;
+    Append( _boot );
+
+    Out( "FlightRecorder: %s, %d events from the last session\n", EventStr( _boot ).c_str(), _previous );
+}
+
+
+// the text itself, not the format.  (a %s argument's pointer means nothing after a reset)
+void
+FlightRecorder::Log( char const *text )
+{
+    Event       event;
+
+    memset( &event, 0, sizeof(event) );
+    event._ms = g_ms;
+    event._kind = Kind::Log;
+    strncpy( event._text, text, sizeof(event._text) );
+    Append( event );
+}
+
+
+void
+FlightRecorder::FrameLag( uint32 lagMs )
+{
+    // a burst of lags is one event.  so they don't push everything else out
+    if ( (_last._kind == Kind::FrameLag) && (g_ms - _last._ms < FRAME_LAG_COALESCE_MS) )
+    {
+        Event       event   = _last;
+
+        event._ms = g_ms;
+        event._extra = MIN( event._extra + 1, 0xFFFF );
+        event._data = MAX( event._data, lagMs );
+        Rewrite( event );
+        return;
+    }
+
+    Event       event;
+
+    event._ms = g_ms;
+    event._kind = Kind::FrameLag;
+    event._value = 0;
+    event._extra = 1;
+    event._data = lagMs;
+    event._data2 = 0;
+    Append( event );
+}
+
+
+void
+FlightRecorder::State( Kind kind, uint8 state )
+{
+    Event       event;
+
+    event._ms = g_ms;
+    event._kind = kind;
+    event._value = state;
+    event._extra = 0;
+    event._data = 0;
+    event._data2 = 0;
+    Append( event );
+}
+
+
+void
+FlightRecorder::Append( Event const &event )
+{
+    if ( _ready )
+    {
+        const uint32    ps  = xt_rsil( 15 );
+
+        _memory.Write( EVENT_OFFSET( _header._count % k_events ), (uint32 const *) &event, sizeof(event) );
+        _header._count += 1;
+        _memory.Write( k_offset, (uint32 const *) &_header, sizeof(_header) );
+        _last = event;
+
+        xt_wsr_ps( ps );
+    }
+}
+
+
+void
+FlightRecorder::Rewrite( Event const &event )
+{
+    if ( (_ready) && (_header._count) )
+    {
+        const uint32    ps  = xt_rsil( 15 );
+
+        _memory.Write( EVENT_OFFSET( (_header._count - 1) % k_events ), (uint32 const *) &event, sizeof(event) );
+        _last = event;
+
+        xt_wsr_ps( ps );
+    }
+}
+
+
+uint
+FlightRecorder::Previous() const
+{
+    return _previous;
+}
+
+
+FlightRecorder::Event const &
+FlightRecorder::PreviousEvent( uint index ) const
+{
+    return _previousEvents[ index ];
+}
+
+
+FlightRecorder::Event const &
+FlightRecorder::BootEvent() const
+{
+    return _boot;
+}
+
+
+uint32
+FlightRecorder::BuildId() const
+{
+    return _header._buildId;
+}
+
+
+char const *
+FlightRecorder::ResetReasonStr( uint32 reason )
+{
+    switch ( reason )
+    {
+    case REASON_DEFAULT_RST:        return "Power on";
+    case REASON_WDT_RST:            return "Hardware watchdog";
+    case REASON_EXCEPTION_RST:      return "Exception";
+    case REASON_SOFT_WDT_RST:       return "Software watchdog";
+    case REASON_SOFT_RESTART:       return "Restart";
+    case REASON_DEEP_SLEEP_AWAKE:   return "Deep sleep wake";
+    case REASON_EXT_SYS_RST:        return "External reset";
+    }
+
+    return "Unknown";
+}
+
+
+String
+FlightRecorder::EventTimeStr( Event const &event )
+{
+    String      str;
+
+    AppendF( str, "%d.%03d", event._ms / 1000, event._ms % 1000 );
+    return str;
+}
+
+
+String
+FlightRecorder::EventStr( Event const &event )
+{
+    String      str;
+
+    switch ( event._kind )
+    {
+    case Kind::Boot:
+        AppendF( str, "Reset: %s", ResetReasonStr( event._value ) );
+        if ( event._value == REASON_EXCEPTION_RST )
+        {
+            AppendF( str, " (%d) epc1 0x%08x excvaddr 0x%08x", event._extra, event._data, event._data2 );
+        }
+        break;
+
+    case Kind::Log:
+    {
+        char        text[ k_text + 1 ];
+
+        memcpy( text, event._text, k_text );
+        text[ k_text ] = 0;
+        str = text;
+        break;
+    }
+
+    case Kind::FrameLag:
+        AppendF( str, "FrameLag: %d, up to %dms", event._extra, event._data );
+        break;
+
+    case Kind::NtpState:
+        AppendF( str, "Ntp: %s", NtpClient::StateStr( NtpClient::State(event._value) ) );
+        break;
+
+    case Kind::TimeZoneState:
+        AppendF( str, "TimeZone: %s", TimeZone::StateStr( TimeZone::State(event._value) ) );
+        break;
+
+    case Kind::ColorState:
+        AppendF( str, "GlobalColor: %s", GlobalColor::StateStr( GlobalColor::State(event._value) ) );
+        break;
+
+    default:
+        AppendF( str, "? %d", int(event._kind) );
+        break;
+    }
+
+    return str;
+}
@@ -0,0 +1,99 @@
+/*
+ * FlightRecorder.h
+ *  The last few log records, frame lags and state changes, kept in RTC user memory so
+ *  they survive a watchdog, exception or soft reset.  On boot the previous session's
+ *  events are copied out (to be shown on /stats) along with why the chip reset.
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+// the memory the recorder lives in.  (so the recorder can be run against simulated memory)
+class FlightMemory
+{
+public:
+    virtual bool        Read( uint32 offset, uint32 *data, uint32 size ) = 0;           // offset is in 4 byte blocks
+    virtual bool        Write( uint32 offset, uint32 const *data, uint32 size ) = 0;
+};
+
+
+class FlightRecorder
+{
+public:
+    static const uint32     k_offset    = 32;       // rtc user memory block.  (the first blocks are left for the boot loader)
+    static const uint       k_events    = 11;       // fills the rest of the 512 bytes
+    static const uint       k_text      = 24;       // chars of a Log event's text kept
+
+    enum class Kind : uint8
+    {
+        None,
+        Boot,                                       // _value reason, _extra exccause, _data epc1, _data2 excvaddr
+        Log,                                        // _text the start of the rendered record
+        FrameLag,                                   // _extra count, _data largest lag ms
+        NtpState,                                   // _value NtpClient::State
+        TimeZoneState,                              // _value TimeZone::State
+        ColorState,                                 // _value GlobalColor::State
+    };
+
+    struct Event
+    {
+        uint32          _ms;                        // g_ms
+        Kind            _kind;
+        uint8           _value;
+        uint16          _extra;
+        union
+        {
+            struct
+            {
+                uint32  _data;
+                uint32  _data2;
+            };
+            char        _text[ k_text ];            // not terminated if it's full
+        };
+    };
+
+public:
+    FlightRecorder( FlightMemory &memory );
+
+    void                Setup();                    // copy out the previous session and start a new one
+    void                Start( uint32 buildId, uint32 reason, uint32 exccause, uint32 epc1, uint32 excvaddr );
+
+    void                Log( char const *text );   // (just the start is kept)
+    void                FrameLag( uint32 lagMs );
+    void                State( Kind kind, uint8 state );
+
+    uint                Previous() const;           // # of events from the previous session
+    Event const       & PreviousEvent( uint index ) const;   // oldest first
+    Event const       & BootEvent() const;          // why this session started
+    uint32              BuildId() const;            // the first 32 bits of the sketch's md5
+
+    static String       EventTimeStr( Event const &event );         // seconds since boot
+    static String       EventStr( Event const &event );
+    static char const * ResetReasonStr( uint32 reason );
+
+private:
+    struct Header
+    {
+        uint32          _magic;
+        uint32          _buildId;                   // events from another build can't be rendered (the format pointers moved)
+        uint32          _count;                     // events written this session.  the next goes in _count % k_events
+        uint32          _boots;                     // sessions recorded
+    };
+
+    void                Append( Event const &event );
+    void                Rewrite( Event const &event );          // replace the last event
+
+private:
+    FlightMemory      & _memory;
+    bool                _ready;
+    Header              _header;
+    Event               _last;                      // copy of the last event written
+    Event               _boot;
+    uint8               _previous;
+    Event               _previousEvents[ k_events ];
+};
+
+
+extern FlightRecorder   g_flightRecorder;
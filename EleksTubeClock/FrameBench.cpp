@@ -0,0 +1,82 @@
+/*
+ * FrameBench
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+#include "platform.h"
+#include "FrameBench.h"
+#include "Columns.h"
+#include <algorithm>
+
+#define MAX_BENCH_FRAMES        240
+
+
+FrameBench::FrameBench( uint frames )
+{
+    const uint32    budgetNs    = MS_PER_FRAME * 1000 * 1000;
+    const uint      columns     = FrameTimer::FrameMax + 1;         // +1 for the frame total
+    uint32        * samples;
+    uint            overBudget  = 0;
+
+    frames = constrain( frames, 1, MAX_BENCH_FRAMES );
+    samples = new uint32[ frames * columns ];
+
+    Out( "Bench: %d frames\n", frames );
+    for ( uint frame=0; frame < frames; ++frame )
+    {
+        uint32      total   = 0;
+
+        g_frameTimer.Start();
+        UpdateTime();
+        NextFrame();
+
+        for ( uint stage=0; stage < FrameTimer::FrameMax; ++stage )
+        {
+            const uint32    ns  = FrameTimer::CyclesToNs( g_frameTimer.Get( FrameTimer::Stage(stage) ) );
+
+            samples[ stage*frames + frame ] = ns;
+            total += ns;
+        }
+
+        samples[ FrameTimer::FrameMax*frames + frame ] = total;
+        if ( total > budgetNs )
+        {
+            overBudget += 1;
+        }
+
+        yield();
+    }
+
+    // percentiles per stage
+    {
+        Columns     out( 2, ". ", ':', nullptr );
+
+        for ( uint column=0; column < columns; ++column )
+        {
+            uint32    * p = samples + column*frames;
+
+            std::sort( p, p + frames );
+        }
+
+        for ( uint pass=0; pass < 2; ++pass )
+        {
+            out.SetPass( pass );
+            for ( uint column=0; column < columns; ++column )
+            {
+                uint32 const  * p       = samples + column*frames;
+                char const    * name    = ( column < FrameTimer::FrameMax ? FrameTimer::StageStr(FrameTimer::Stage(column)) : "Frame" );
+
+                out.Row2( 
+                    name,
+                    PrintF( "p50 %d, p90 %d, p99 %d, max %d ns", p[ frames*50/100 ], p[ frames*90/100 ], p[ frames*99/100 ], p[ frames-1 ] ) );
+            }
+            out.Row2( "Budget", PrintF( "%d ns, %d over", budgetNs, overBudget ) );
+        }
+    }
+
+    delete[] samples;
+}
@@ -0,0 +1,16 @@
+/*
+ * FrameBench.h
+ *  Runs frames back to back and reports the cost of each stage of NextFrame().
+ *  Accessible from the Console to catch frame budget regressions before flashing clocks.
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+class FrameBench
+{
+public:
+    FrameBench( uint frames );
+};
@@ -0,0 +1,87 @@
+/*
+ * FrameTimer
+ *  Cycle counts for each stage of the frame and each phase of loop().
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+#include "platform.h"
+
+
+uint32
+FrameTimer::Cycles()
+{
+    return ESP.getCycleCount();
+}
+
+
+uint32
+FrameTimer::CyclesToNs( uint32 cycles )
+{
+    return uint32( (uint64(cycles) * 1000) / ESP.getCpuFreqMHz() );
+}
+
+
+uint32
+FrameTimer::CyclesToUs( uint32 cycles )
+{
+    return ( cycles / ESP.getCpuFreqMHz() );
+}
+
+
+char const *
+FrameTimer::StageStr( Stage stage )
+{
+    switch ( stage )
+    {
+    case Time:          return "Time";
+    case State:         return "State";
+    case Digits:        return "Digits";
+    case Show:          return "Show";
+    case NtpLoop:       return "Ntp";
+    case TimeZoneLoop:  return "TimeZone";
+    case OnOffLoop:     return "OnOff";
+    case DimLoop:       return "Dim";
+    case SettingsLoop:  return "Settings";
+    case ConsoleLoop:   return "Console";
+    case WiFiLoop:      return "WiFi";
+    case NtpPoll:       return "NtpPoll";
+    }
+
+    return nullptr;
+}
+
+
+void
+FrameTimer::Start()
+{
+    _last = Cycles();
+}
+
+
+void
+FrameTimer::Mark( Stage stage )
+{
+    const uint32    now = Cycles();
+
+    _cycles[ stage ] = now - _last;
+    _histogram[ stage ].Push( CyclesToUs(_cycles[ stage ]) );
+    _last = now;
+}
+
+
+uint32
+FrameTimer::Get( Stage stage ) const
+{
+    return _cycles[ stage ];
+}
+
+
+Histogram const &
+FrameTimer::GetHistogram( Stage stage ) const
+{
+    return _histogram[ stage ];
+}
@@ -0,0 +1,56 @@
+/*
+ * FrameTimer.h
+ *  Cycle counts for each stage of the frame and each phase of loop().
+ *  The last frame is kept for the "bench" console command, and every stage feeds
+ *  a histogram shown on the stats pages to find what eats the MS_PER_FRAME budget.
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+class FrameTimer
+{
+public:
+    enum Stage : uint8
+    {
+        // NextFrame()
+        Time,                               // UpdateTime() and new second handling
+        State,                              // GlobalColor::NextFrame()
+        Digits,                             // EleksDigit::NextFrame() and dimming
+        Show,                               // ShowLeds()
+        FrameMax,
+
+        // loop()
+        NtpLoop         = FrameMax,         // UpdateType::Ntp
+        TimeZoneLoop,                       // UpdateType::TimeZone and polling while syncing
+        OnOffLoop,                          // UpdateType::OnOff
+        DimLoop,                            // UpdateType::Dim
+        SettingsLoop,                       // UpdateType::Settings
+        ConsoleLoop,                        // Console::Loop()
+        WiFiLoop,                           // WiFiAp::Loop(). includes handleClient()
+        NtpPoll,                            // fast polling while waiting for an ntp response
+        StageMax
+    };
+
+public:
+    static uint32       Cycles();
+    static uint32       CyclesToNs( uint32 cycles );
+    static uint32       CyclesToUs( uint32 cycles );
+    static char const * StageStr( Stage stage );
+
+public:
+    void                Start();            // start timing (the next stage)
+    void                Mark( Stage stage );// end of "stage"
+    uint32              Get( Stage stage ) const;
+    Histogram const   & GetHistogram( Stage stage ) const;
+
+private:
+    uint32              _last;              // cycle count at the last Start() or Mark()
+    uint32              _cycles[ StageMax ];// cycles spent in each stage the last time it ran
+    Histogram           _histogram[ StageMax ];
+};
+
+
+extern FrameTimer       g_frameTimer;
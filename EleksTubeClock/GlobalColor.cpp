@@ -10,6 +10,14 @@
  */
 
 #include "platform.h"
+#include "FlightRecorder.h"
+
+#define FADE_MS             1000        // cross fade to/from black
+#define BLEND_MS            800         // blend between the time and the effect
+#define FLASH_OFF_MS        50
+#define FLASH_ON_MS         100
+#define PULSE_MS            600         // each half of a pulse
+#define MAX_STEPS_PER_FRAME 16          // (in case the table loops on steps that take no time)
 
 extern ARGB   g_popupColor;
 
@@ -18,13 +26,66 @@ const ARGB    GlobalColor::k_notSet = { (ARGB::BlendOut   | 0), 0x20, 0x00, 0x00
 const ARGB    GlobalColor::k_error  = { (ARGB::BlendOut   | 5), 0xFF, 0x00, 0x00 };         
 
 
+const GlobalColor::Step     GlobalColor::k_steps[] PROGMEM =
+{
+    // Appear
+    { Color,                Timing::Hold,           Ease::Linear,   0x00, 0xFF, 0               },
+
+    // CrossFade
+    { Black | Background,   Timing::Ramp,           Ease::Linear,   0x00, 0xFF, FADE_MS         },
+    { Scaled,               Timing::Ramp,           Ease::Linear,   0x00, 0xFF, FADE_MS         },
+    { Color,                Timing::Hold,           Ease::Linear,   0x00, 0xFF, 0               },
+    { Scaled,               Timing::Ramp,           Ease::Linear,   0xFF, 0x00, FADE_MS         },
+    { Black | Background,   Timing::Ramp,           Ease::Linear,   0xFF, 0x00, FADE_MS         },
+
+    // BlendInOut
+    { Blend,                Timing::Ramp,           Ease::Linear,   0x00, 0xFF, BLEND_MS        },
+    { Color,                Timing::Hold,           Ease::Linear,   0x00, 0xFF, 0               },
+    { Blend,                Timing::Ramp,           Ease::Linear,   0xFF, 0x00, BLEND_MS        },
+
+    // BlendOut
+    { Color,                Timing::Hold,           Ease::Linear,   0x00, 0xFF, 0               },
+    { Blend,                Timing::Ramp,           Ease::Linear,   0xFF, 0x00, BLEND_MS        },
+
+    // Flash
+    { Black,                Timing::Ramp,           Ease::Linear,   0xFF, 0xFF, FLASH_OFF_MS    },
+    { Color,                Timing::Ramp,           Ease::Linear,   0xFF, 0xFF, FLASH_ON_MS     },
+    { Black,                Timing::Ramp,           Ease::Linear,   0xFF, 0xFF, FLASH_OFF_MS    },
+    { Color,                Timing::RepeatCount,    Ease::Linear,   2,    0,    0               },
+
+    // Pulse
+    { Blend,                Timing::Ramp,           Ease::Linear,   0x00, 0xFF, BLEND_MS        },
+    { Blend,                Timing::Ramp,           Ease::InOut,    0xFF, 0x40, PULSE_MS        },
+    { Blend,                Timing::Ramp,           Ease::InOut,    0x40, 0xFF, PULSE_MS        },
+    { Blend,                Timing::RepeatHeld,     Ease::Linear,   2,    0,    0               },
+    { Blend,                Timing::Ramp,           Ease::Linear,   0xFF, 0x00, BLEND_MS        },
+};
+
+
+const GlobalColor::Effect   GlobalColor::k_effects[] PROGMEM =
+{
+    {  0, 1 },      // Appear
+    {  1, 5 },      // CrossFade
+    {  6, 3 },      // BlendInOut
+    {  9, 2 },      // BlendOut
+    { 11, 4 },      // Flash
+    { 15, 5 },      // Pulse
+};
+
+
 GlobalColor::GlobalColor()
     : _activeStates     ( 0 )
     , _displayStates    ( 0 )
     , _state            ( MaxState )
-    , _changingState    ( StateChange::None )
+    , _step             ( 0 )
+    , _level            ( 0 )
+    , _repeats          ( 0 )
+    , _stepStart        ( 0 )
     , _holdEnd          ( 0 )
+    , _released         ( false )
 {
+    memset( &_effect, 0, sizeof(_effect) );
+    memset( &_stepData, 0, sizeof(_stepData) );
 }
 
 
@@ -71,24 +132,30 @@ GlobalColor::IsWifiClientActive() const
 bool
 GlobalColor::IsTurnedOff() const
 {
-    return (_state == TimeOff) && (_changingState == StateChange::Holding);
+    return (_state == TimeOff) && (_effect._count) && (_stepData._timing == Timing::Hold);
 }
 
 
+// a held hold step is static.  its release is picked up by the next (idle) frame
+bool
+GlobalColor::IsAnimating() const
+{
+    if ( !_displayStates )
+    {
+        return false;
+    }
+
+    return !( (_effect._count) &&
+              (_stepData._timing == Timing::Hold) &&
+              (_activeStates & (1 << _state)) &&
+              (FirstSetBit16( _displayStates ) == _state) );
+}
+
 
 GlobalColor::State
 GlobalColor::IsDisplaying() const
 {
-    static const uint32     k_stateForeground =
-        (1 << uint(StateChange::Holding))      |
-        (1 << uint(StateChange::FadingIn1))    |
-        (1 << uint(StateChange::FadingOut2))   |
-        (1 << uint(StateChange::BlendingIn))   |
-        (1 << uint(StateChange::BlendingOut))  |
-        (1 << uint(StateChange::FlashingOff))  |
-        (1 << uint(StateChange::FlashingOn));
-
-    if ( k_stateForeground & (1 << uint(_changingState)) )
+    if ( (_effect._count) && (!(_stepData._look & Background)) )
     {
         return _state;
     }
@@ -100,9 +167,17 @@ GlobalColor::IsDisplaying() const
 char const * 
 GlobalColor::IsDisplayingStr() const 
 {
-    switch( IsDisplaying() )
+    return StateStr( IsDisplaying() );
+}
+
+
+char const *
+GlobalColor::StateStr( State state )
+{
+    switch( state )
     {
     case Popup:                 return "Popup";
+    case TimeNotSet:            return "TimeNotSet";
     case TimeOff:               return "TimeOff";
     case TimeError:             return "TimeError";
     case ClientRequest:         return "ClientRequest";
@@ -121,17 +196,7 @@ GlobalColor::IsDisplayingStr() const
 bool
 GlobalColor::IsBlend() const
 {
-    bool        blend = false;
-
-    switch ( _changingState )
-    {
-    case StateChange::BlendingIn:
-    case StateChange::BlendingOut:
-        blend = true;
-        break;
-    }
-
-    return blend;
+    return ( (_effect._count) && ((_stepData._look & LookMask) == Blend) );
 }
 
 
@@ -147,20 +212,22 @@ GlobalColor::GetColor() const
 {
     ARGB    argb = _stateColor;
 
-    switch( _changingState )
+    switch( _stepData._look & LookMask )
     {
-    case StateChange::FadingOut1:
-    case StateChange::FadingIn2:
-    case StateChange::FlashingOff:
+    case Black:
         argb = { 0, 0, 0, 0 };
-        argb.alpha = _stateColor.alpha;
+        argb.alpha = _level;
         break;
 
-    case StateChange::FadingIn1:
-    case StateChange::FadingOut2:
-        nscale8x3( argb.red, argb.green, argb.blue, argb.alpha );
+    case Scaled:
+        nscale8x3( argb.red, argb.green, argb.blue, _level );
         argb.alpha = 0xFF;
         break;
+
+    case Color:
+    case Blend:
+        argb.alpha = _level;
+        break;
     }
 
     return argb;
@@ -211,13 +278,42 @@ GlobalColor::EnableState( State state )
 void 
 GlobalColor::ClearState( State state )
 {
-    if ( _activeStates & (1 << state) )
+    // (the hold time starts when the effect reaches its hold step and sees the state is released)
+    _activeStates &= ~(1 << state);
+}
+
+
+bool
+GlobalColor::IsHeld()
+{
+    if ( _activeStates & (1 << _state) )
     {
-        _activeStates &= ~(1 << state);
-        if ( (_state == state) && (_changingState == StateChange::Holding) )
-        {
-            _holdEnd = g_ms + (_stateFlags & ARGB::HoldTimeMask) * 1000;
-        }
+        _released = false;
+        return true;
+    }
+
+    if ( !_released )
+    {
+        _released = true;
+        _holdEnd = g_ms + (_stateFlags & ARGB::HoldTimeMask) * 1000;
+    }
+
+    return ( int32(g_ms - _holdEnd) < 0 );
+}
+
+
+void
+GlobalColor::StartStep( uint8 step )
+{
+    if ( step < _effect._count )
+    {
+        _step = step;
+        memcpy_P( &_stepData, &k_steps[ _effect._first + step ], sizeof(_stepData) );
+    }
+    else
+    {
+        // done
+        _effect._count = 0;
     }
 }
 
@@ -226,13 +322,12 @@ GlobalColor::ClearState( State state )
 void
 GlobalColor::NextFrame()
 {
-    const StateChange   oldChangingState    = _changingState;
     const State         newState            = State( FirstSetBit16(_displayStates) );
-    const uint          curMs               = millis();
 
     if ( newState != _state )
     {
-        ARGB            stateArgb       = *ColorOptions( newState );
+        const ARGB      stateArgb       = *ColorOptions( newState );
+        const uint      effect          = ( stateArgb.alpha & ARGB::EffectMask ) >> 4;
 
         // Check if we should change states now
         if ( (_state != MaxState) && (!(_activeStates & (1 << _state))) )
@@ -241,148 +336,74 @@ GlobalColor::NextFrame()
         }
         
         _state = newState;
+        g_flightRecorder.State( FlightRecorder::Kind::ColorState, newState );
         _stateFlags = stateArgb.alpha;
         _stateColor = stateArgb;
 
-        _holdEnd = 0;
-        _changingState = StateChange::Holding;
-
-        switch ( _stateFlags & ARGB::EffectMask )
-        { 
-        case ARGB::CrossFade:
-            _changingState = StateChange::FadingOut1;
-            _stateColor.alpha = 0;
-            break;
-
-        case ARGB::BlendInOut:
-            _changingState = StateChange::BlendingIn;
-            _stateColor.alpha = 0;
-            break;
-
-        case ARGB::Flash:
-            _changingState = StateChange::FlashingOff;
-            _holdEnd = curMs + 50;
-            _flashCount = 0;
-            break;
-        }
-        
+        // (unknown effects appear)
+        memcpy_P( &_effect, &k_effects[ (effect < countof(k_effects)) ? effect : 0 ], sizeof(_effect) );
+        _repeats = 0;
+        _released = false;
+        _stepStart = g_ms;
+        StartStep( 0 );
     }
 
-    switch( _changingState )
+    // play the effect's steps up to g_ms
+    for ( uint guard = 0; (_effect._count) && (guard < MAX_STEPS_PER_FRAME); ++guard )
     {
-    case StateChange::Holding:
-        _stateColor.alpha = 0xFF;
-        if ( _activeStates & (1 << _state) )
-        {
-            // reset the end time
-            _holdEnd = 0;
-        }
-        else
+        const uint32    elapsed = g_ms - _stepStart;
+
+        if ( _stepData._timing == Timing::Ramp )
         {
-            // if end time not set, do it now
-            if ( !_holdEnd )
-            {
-                _holdEnd = curMs + (_stateFlags & ARGB::HoldTimeMask) * 1000;
-            }
-            else if ( curMs >= _holdEnd )
+            if ( elapsed < _stepData._ms )
             {
-                _changingState = StateChange::None;
-                switch( _stateFlags & ARGB::EffectMask )
-                {
-                case ARGB::CrossFade:
-                    _changingState = StateChange::FadingOut2;
-                    break;
-
-                case ARGB::BlendOut:
-                case ARGB::BlendInOut:
-                    _changingState = StateChange::BlendingOut;
-                    break;
+                uint8   fraction = ( elapsed << 8 ) / _stepData._ms;
 
-                case ARGB::Flash:
-                    break;
+                if ( _stepData._ease == Ease::InOut )
+                {
+                    fraction = ease8InOutCubic( fraction );
                 }
+                _level = lerp8by8( _stepData._from, _stepData._to, fraction );
+                break;
             }
+
+            // (carry the time over, so the steps keep their timing when a frame is late)
+            _stepStart += _stepData._ms;
+            _level = _stepData._to;
+            StartStep( _step + 1 );
         }
-        break;
-        
-    case StateChange::FlashingOff:
-        _stateColor.alpha = 0xFF;
-        if ( curMs >= _holdEnd )
+        else if ( _stepData._timing == Timing::Hold )
         {
-            _changingState = StateChange::FlashingOn;
-            _holdEnd = curMs + 100;
-
-            if ( _flashCount > (_stateFlags & ARGB::HoldTimeMask) )
+            _level = _stepData._to;
+            if ( IsHeld() )
             {
-                _changingState = StateChange::None;
+                break;
             }
-        }
-        break;
 
-    case StateChange::FlashingOn:
-        if (curMs >= _holdEnd)
-        {
-            _changingState = StateChange::FlashingOff;
-            _holdEnd = curMs + 50;
-            _flashCount += 1;
+            _stepStart = g_ms;
+            StartStep( _step + 1 );
         }
-        break;
-
-    case StateChange::FadingOut1:
-        _stateColor.alpha += 4;
-        if ( _stateColor.alpha > (255-4) )
+        else if ( _stepData._timing == Timing::RepeatHeld )
         {
-            _stateColor.alpha = 1; 
-            _changingState = StateChange::FadingIn1;
+            StartStep( IsHeld() ? _step - _stepData._from : _step + 1 );
         }
-        break;
-
-    case StateChange::FadingIn1:
-        _stateColor.alpha += 4;
-        if ( _stateColor.alpha > (255-4) )
-        {
-            _changingState = StateChange::Holding;
-        }
-        break;
-
-    case StateChange::FadingOut2:
-        _stateColor.alpha -= 4;
-        if ( _stateColor.alpha < 4 )
-        {
-            _stateColor.alpha = 255;
-            _changingState = StateChange::FadingIn2;
-        }
-        break;
-
-    case StateChange::FadingIn2:
-        _stateColor.alpha -= 4;
-        if ( _stateColor.alpha < 4 )
-        {
-            _changingState = StateChange::None;
-        }
-        break;
-
-    case StateChange::BlendingIn:
-        _stateColor.alpha += 5;
-        if ( _stateColor.alpha > (255-5) )
-        {
-            _changingState = StateChange::Holding;
-        }
-        break;
-
-    case StateChange::BlendingOut:
-        _stateColor.alpha -= 5;
-        if ( !_stateColor.alpha )
+        else
         {
-            _changingState = StateChange::None;
+            if ( _repeats < (_stateFlags & ARGB::HoldTimeMask) )
+            {
+                _repeats += 1;
+                StartStep( _step - _stepData._from );
+            }
+            else
+            {
+                StartStep( _step + 1 );
+            }
         }
-        break;
     }
     
-    if ( _changingState == StateChange::None )
+    if ( !_effect._count )
     {
         _displayStates &= ~(1 << _state);
         _state = MaxState;
     }
 }
-
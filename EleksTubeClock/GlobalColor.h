@@ -4,6 +4,8 @@
  *  When a state is activated it triggers a corresponding effect to transistion to (and then
  *  from) that state.  If no state is activated, the current time is displayed.
  *
+ *  The effects are tables of steps (see k_steps) that are played back by elapsed time.
+ *
  * Author: Ken Reneris <https://github.com/KenReneris>
  * MIT License
  * ----------------------------------------------------------
@@ -43,49 +45,85 @@ public:
 
     State           IsDisplaying() const;           // which state is active
     char const    * IsDisplayingStr() const;
+    static char const * StateStr( State state );   // MaxState is "Time"
     bool            IsBlend() const;                // If the values are blending.  
     uint32          IsPending( State state ) const; // non-zero if the "state" is set.  Set but might not be displaying if a higher priority state is also set.
     bool            IsWifiClientActive() const;     // if the ClientRequest is set (used to poll the web requests for frequently)
     bool            IsTurnedOff() const;            // if the TimeOff is set.
+    bool            IsAnimating() const;            // the next frames will differ.  (anything but holding a state that's held on)
 
 private:
-    enum class StateChange : uint8
+    // how a step of an effect is shown.  (what GetColor() returns)
+    enum Look : uint8
+    {
+        Black,              // black at the level's alpha.  (fades the time out)
+        Scaled,             // the color scaled by the level
+        Color,              // the color at the level's alpha
+        Blend,              // Color, but the time and effect values are both shown (IsBlend())
+        LookMask            = 0x0F,
+        Background          = 0x80,     // the state isn't considered to be displaying yet (or any more)
+    };
+
+    // how a step advances
+    enum class Timing : uint8
     {
-        None,
+        Ramp,               // _from to _to over _ms
+        Hold,               // _to while the state is held on (and its hold time after)
+        RepeatHeld,         // go back _from steps while the state is held on
+        RepeatCount,        // go back _from steps.  the hold time # of times
+    };
 
-        // Cross fade sequence
-        FadingOut1,         // foreground to black
-        FadingIn1,          // black to global color
-        Holding,            // global color
-        FadingOut2,         // global color to black
-        FadingIn2,          // black to foreground
+    enum class Ease : uint8
+    {
+        Linear,
+        InOut,              // eased at both ends
+    };
 
-        BlendingIn,         // foreground to global color
-        BlendingOut,        // global color to foreground
+    struct Step
+    {
+        uint8           _look;
+        Timing          _timing;
+        Ease            _ease;
+        uint8           _from;
+        uint8           _to;
+        uint16          _ms;
+    };
 
-        FlashingOff,
-        FlashingOn,
+    struct Effect
+    {
+        uint8           _first;                 // index in k_steps
+        uint8           _count;
     };
 
 private:
     static const ARGB   k_black;
     static const ARGB   k_notSet;
     static const ARGB   k_error;
+    static const Step   k_steps[];
+    static const Effect k_effects[];            // by ARGB::EffectMask
 
 private:
     static ARGB const * ColorOptions( State state );
 
+    void                StartStep( uint8 step );
+    bool                IsHeld();               // the state is on or in its hold time.  (only asked by the Hold/RepeatHeld steps, so the hold time starts there)
+
 private:
     uint32              _activeStates;          // states being held on
     uint32              _displayStates;         // states wanting to be displayed. only the highest priroity is displayed
 
     State               _state;                 // current state
     uint8               _stateFlags;            // current flags from the states effect.  Form: g_options.{_effect}.alpha
-    ARGB                _stateColor;            // current color from the states effect.  Alpha is not the alpha for the effect to use.  Might be ramping on/off, etc..
-
-    StateChange         _changingState;         // current step of the effect being applied (for entering/leaving _state, ..)
-    uint8               _flashCount;            // if the effect is to flash.. the count of flashes
-    uint32              _holdEnd;               // if the effect has a "hold on" time in it's squence, this is when the hold end and the next step of the effect can start
+    ARGB                _stateColor;            // current color from the states effect
+
+    Effect              _effect;                // effect being played for _state.  (_count is 0 when it's done)
+    uint8               _step;                  // current step of _effect
+    Step                _stepData;              // copy of k_steps[ _step ]
+    uint8               _level;                 // the current step's alpha
+    uint8               _repeats;               // RepeatCount loops done
+    uint32              _stepStart;             // g_ms the current step started
+    uint32              _holdEnd;               // when the state was released, the end of its hold time
+    bool                _released;              // _holdEnd is set
 };
 
 
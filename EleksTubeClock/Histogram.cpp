@@ -0,0 +1,75 @@
+/*
+ * Histogram
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+#include "platform.h"
+
+
+void
+Histogram::Push( uint32 us )
+{
+    uint    bucket  = 0;
+
+    if ( us > 1 )
+    {
+        bucket = MIN( 31 - __builtin_clz(us), k_buckets-1 );
+    }
+
+    _counts[ bucket ] += 1;
+    if ( us > _max )
+    {
+        _max = us;
+    }
+}
+
+
+uint32
+Histogram::Count() const
+{
+    uint32      count   = 0;
+
+    for ( uint index=0; index < k_buckets; ++index )
+    {
+        count += _counts[ index ];
+    }
+
+    return count;
+}
+
+
+uint32
+Histogram::Max() const
+{
+    return _max;
+}
+
+
+// Form: "<2:10 <4:300 <64:2 max 40us".  Only non-empty buckets are included
+String
+Histogram::toString() const
+{
+    String      str;
+
+    for ( uint index=0; index < k_buckets; ++index )
+    {
+        if ( _counts[ index ] )
+        {
+            if ( index < k_buckets-1 )
+            {
+                AppendF( str, "<%d:%d ", 2 << index, _counts[index] );
+            }
+            else
+            {
+                AppendF( str, ">=%d:%d ", 1 << index, _counts[index] );
+            }
+        }
+    }
+
+    AppendF( str, "max %dus", _max );
+    return str;
+}
@@ -0,0 +1,25 @@
+/*
+ * Histogram.h
+ *  Fixed log2 buckets of microsecond durations.  Cheap enough to update every frame.
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+class Histogram
+{
+public:
+    static const uint   k_buckets = 16;         // last bucket is >= 32ms
+
+public:
+    void                Push( uint32 us );
+    uint32              Count() const;
+    uint32              Max() const;
+    String              toString() const;
+
+private:
+    uint32              _max;                   // largest value pushed
+    uint32              _counts[ k_buckets ];   // [0] is < 2us, [n] is 2^n .. 2^(n+1)-1 us
+};
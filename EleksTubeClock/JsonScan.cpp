@@ -0,0 +1,203 @@
+/*
+ * JsonScan
+ *  Streaming json field extractor.
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+#include "platform.h"
+
+
+void
+JsonScan::Reset( Field *fields, uint8 count )
+{
+    _fields     = fields;
+    _count      = count;
+    _field      = nullptr;
+    _depth      = 0;
+    _objects    = 0;
+    _expectKey  = false;
+    _inKey      = false;
+    _inString   = false;
+    _inScalar   = false;
+    _escape     = false;
+    _keyLength  = 0;
+
+    for ( uint8 index=0; index < count; ++index )
+    {
+        fields[ index ]._length = 0;
+        fields[ index ]._found = false;
+        fields[ index ]._value[ 0 ] = 0;
+    }
+}
+
+
+JsonScan::Field const *
+JsonScan::Missing() const
+{
+    for ( uint8 index=0; index < _count; ++index )
+    {
+        if ( !_fields[ index ]._found )
+        {
+            return &_fields[ index ];
+        }
+    }
+
+    return nullptr;
+}
+
+
+void
+JsonScan::Push( char c )
+{
+    if ( _inString )
+    {
+        if ( _escape )
+        {
+            // keep the escaped char as is.  e.g., "\/" is "/"
+            _escape = false;
+        }
+        else if ( c == '\\' )
+        {
+            _escape = true;
+            return;
+        }
+        else if ( c == '"' )
+        {
+            _inString = false;
+            if ( _inKey )
+            {
+                _inKey = false;
+                _key[ MIN(_keyLength, sizeof(_key)-1) ] = 0;
+            }
+            else
+            {
+                EndValue();
+            }
+            return;
+        }
+
+        if ( _inKey )
+        {
+            if ( _keyLength < sizeof(_key) )
+            {
+                _key[ _keyLength ] = c;
+                _keyLength += 1;
+            }
+        }
+        else
+        {
+            Capture( c );
+        }
+        return;
+    }
+
+    if ( _inScalar )
+    {
+        if ( (c != ',') && (c != '}') && (c != ']') && (!isspace( (unsigned char) c )) )
+        {
+            Capture( c );
+            return;
+        }
+
+        _inScalar = false;
+        EndValue();
+    }
+
+    switch ( c )
+    {
+    case '{':
+    case '[':
+        _depth += 1;
+        if ( _depth < 16 )
+        {
+            _objects = ( c == '{' ) ? ( _objects | (1 << _depth) ) : ( _objects & ~(1 << _depth) );
+        }
+        _expectKey = ( c == '{' );
+        break;
+
+    case '}':
+    case ']':
+        if ( _depth )
+        {
+            _depth -= 1;
+        }
+        _expectKey = false;
+        break;
+
+    case ',':
+        _expectKey = ( _depth < 16 ) && ( _objects & (1 << _depth) );
+        break;
+
+    case ':':
+        _expectKey = false;
+        break;
+
+    case '"':
+        _inString = true;
+        if ( _expectKey )
+        {
+            _inKey = true;
+            _keyLength = 0;
+        }
+        else
+        {
+            StartValue();
+        }
+        break;
+
+    default:
+        if ( !isspace( (unsigned char) c ) )
+        {
+            _inScalar = true;
+            StartValue();
+            Capture( c );
+        }
+        break;
+    }
+}
+
+
+void
+JsonScan::StartValue()
+{
+    _field = nullptr;
+    if ( (_depth == 1) && (_keyLength < sizeof(_key)) )
+    {
+        for ( uint8 index=0; index < _count; ++index )
+        {
+            if ( strcmp(_key, _fields[ index ]._name) == 0 )
+            {
+                _field = &_fields[ index ];
+                _field->_length = 0;
+                break;
+            }
+        }
+    }
+}
+
+
+void
+JsonScan::Capture( char c )
+{
+    if ( (_field) && (_field->_length < _field->_size-1) )
+    {
+        _field->_value[ _field->_length ] = c;
+        _field->_length += 1;
+    }
+}
+
+
+void
+JsonScan::EndValue()
+{
+    if ( _field )
+    {
+        _field->_value[ _field->_length ] = 0;
+        _field->_found = true;
+        _field = nullptr;
+    }
+}
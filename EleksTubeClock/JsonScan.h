@@ -0,0 +1,48 @@
+/*
+ * JsonScan.h
+ *  Streaming json field extractor.  Bytes are pushed in one at a time as they arrive
+ *  and only the values of the requested top level keys are kept (as text) in the
+ *  callers fixed buffers.  Nothing is allocated and the document is never buffered.
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+class JsonScan
+{
+public:
+    struct Field
+    {
+        char const    * _name;              // top level key to capture
+        char          * _value;             // value as text.  strings are unquoted.  truncated to fit
+        uint8           _size;              // sizeof( _value )
+        uint8           _length;
+        bool            _found;
+    };
+
+public:
+    void            Reset( Field *fields, uint8 count );
+    void            Push( char c );
+    Field const   * Missing() const;        // first field not found yet (or nullptr)
+
+private:
+    void            StartValue();
+    void            Capture( char c );
+    void            EndValue();
+
+private:
+    Field         * _fields;
+    uint8           _count;
+    Field         * _field;                 // field whose value is being captured
+    uint8           _depth;                 // nesting. top level keys are at depth 1
+    uint16          _objects;               // bit per depth. set if that depth is an object (vs. an array)
+    bool            _expectKey;             // next string is a key
+    bool            _inKey;
+    bool            _inString;
+    bool            _inScalar;              // number, true, false, null
+    bool            _escape;                // last char was a '\'
+    uint8           _keyLength;
+    char            _key[ 16 ];             // current key. keys that don't fit never match
+};
@@ -1,6 +1,15 @@
 /*
  * Log
- *  In memory text log for debugging.
+ *  In memory binary log for debugging.
+ *
+ *  Record:     uint16 size, format pointer, LogArgs data
+ *
+ *  Records are appended at g_head and the oldest are dropped to make room.  The
+ *  positions only ever increase (the ring index is position % LOG_RING_SIZE).
+ *  Writers mask interrupts only while copying the record in.  Readers copy a record
+ *  out the same way and format it outside the lock.  The record path (and the flight
+ *  recorder it feeds) runs from flash, so Log() must not be called from an interrupt
+ *  handler.
  *
  * Author: Ken Reneris <https://github.com/KenReneris>
  * MIT License
@@ -8,86 +17,366 @@
  */
 
 #include "platform.h"
+#include "FlightRecorder.h"
+
+#define LOG_RING_SIZE       1024
+#define LOG_HEADER_SIZE     ( sizeof(uint16) + sizeof(char const *) )
+#define LOG_DRAIN_RECORDS   4               // per LogDrain() call
+
+
+static uint8            g_ring[ LOG_RING_SIZE ];
+static uint32           g_head;             // position of the next record
+static uint32           g_oldest;           // position of the oldest record in the ring
+static uint32           g_drained;          // position of the next record to send to the serial port
+static uint32           g_records;          // # of records logged
+static uint32           g_undrained;        // # of records dropped before they were sent to the serial port
+
+
+LogArgs::LogArgs()
+    : _size         ( 0 )
+{
+}
+
 
+uint8 const *
+LogArgs::Data() const
+{
+    return _data;
+}
 
 
-static uint16   g_logTail;
-static char     g_log[ 512 ];
+uint
+LogArgs::Size() const
+{
+    return _size;
+}
 
 
 void
-AppendToLog( char const *txt )
+LogArgs::PutWord( uint32 value )
 {
-    for( ; *txt; ++txt )
+    if ( _size + 1 + sizeof(value) <= sizeof(_data) )
     {
-        g_log[ g_logTail ] = *txt;
-        g_logTail += 1;
-        if( g_logTail >= countof(g_log) )
-        {
-            g_logTail = 0;
-        }
+        _data[ _size ] = Word;
+        memcpy( _data + _size + 1, &value, sizeof(value) );
+        _size += 1 + sizeof(value);
     }
 }
 
 
-void    
-Log( char const *format, ... )
+void
+LogArgs::Put( double value )
 {
-    va_list         args;
-    StringBuffer    sb(
-        []( char const *txt )
+    const float     f = value;
+
+    if ( _size + 1 + sizeof(f) <= sizeof(_data) )
+    {
+        _data[ _size ] = Float;
+        memcpy( _data + _size + 1, &f, sizeof(f) );
+        _size += 1 + sizeof(f);
+    }
+}
+
+
+void
+LogArgs::Put( char const *str )
+{
+    uint    length = str ? strnlen( str, k_maxString ) : 0;
+
+    if ( _size + 2 <= sizeof(_data) )
+    {
+        length = MIN( length, sizeof(_data) - _size - 2 );
+        _data[ _size ] = Str;
+        _data[ _size + 1 ] = length;
+        memcpy( _data + _size + 2, str, length );
+        _size += 2 + length;
+    }
+}
+
+
+void
+LogArgs::Put( String const &str )
+{
+    Put( str.c_str() );
+}
+
+
+static void
+RingWrite( uint32 pos, void const *data, uint size )
+{
+    uint8 const   * bytes = (uint8 const *) data;
+
+    for ( uint index = 0; index < size; ++index )
+    {
+        g_ring[ (pos + index) % LOG_RING_SIZE ] = bytes[ index ];
+    }
+}
+
+
+static void
+RingRead( uint32 pos, void *data, uint size )
+{
+    uint8     * bytes = (uint8 *) data;
+
+    for ( uint index = 0; index < size; ++index )
+    {
+        bytes[ index ] = g_ring[ (pos + index) % LOG_RING_SIZE ];
+    }
+}
+
+
+static uint16
+RecordSize( uint32 pos )
+{
+    uint16      size;
+
+    RingRead( pos, &size, sizeof(size) );
+    return size;
+}
+
+
+void
+LogRecord( char const *format, LogArgs const &args )
+{
+    const uint16    size = LOG_HEADER_SIZE + args.Size();
+    const uint32    ps   = xt_rsil( 15 );
+
+    // make room
+    while ( g_head + size - g_oldest > LOG_RING_SIZE )
+    {
+        if ( g_drained == g_oldest )
         {
-            OutStr( txt );
-            AppendToLog( txt );
+            g_drained += RecordSize( g_oldest );
+            g_undrained += 1;
         }
-    );
+        g_oldest += RecordSize( g_oldest );
+    }
+
+    RingWrite( g_head, &size, sizeof(size) );
+    RingWrite( g_head + sizeof(size), &format, sizeof(format) );
+    RingWrite( g_head + LOG_HEADER_SIZE, args.Data(), args.Size() );
+    g_head += size;
+    g_records += 1;
 
-    va_start( args, format );
-    sb.VAddF( format, args );
-    va_end( args );
+    xt_wsr_ps( ps );
+
+    // the flight recorder keeps the start of the text.  (on one line)
+    char            text[ FlightRecorder::k_text + 1 ];
+    uint            length  = 0;
+    StringBuffer    sb(
+        [&text, &length]( char const *txt )
+        {
+            for ( ; (*txt) && (length < FlightRecorder::k_text); ++txt )
+            {
+                if ( *txt != '\n' )
+                {
+                    text[ length++ ] = *txt;
+                }
+            }
+        } );
+
+    LogRender( format, args.Data(), args.Size(), sb );
+    sb.Flush();
+    text[ length ] = 0;
+    g_flightRecorder.Log( text );
+}
+
+
+// copy the record at *pos out of the ring and advance *pos.  false if there are no more
+static bool
+CopyRecord( uint32 &pos, char const *&format, uint8 *args, uint &argsSize )
+{
+    const uint32    ps  = xt_rsil( 15 );
+    bool            ok  = false;
+
+    // (a reader that fell behind skips to the oldest record)
+    if ( int32(pos - g_oldest) < 0 )
+    {
+        pos = g_oldest;
+    }
+
+    if ( pos != g_head )
+    {
+        const uint16    size = RecordSize( pos );
+
+        RingRead( pos + sizeof(size), &format, sizeof(format) );
+        argsSize = size - LOG_HEADER_SIZE;
+        RingRead( pos + LOG_HEADER_SIZE, args, argsSize );
+        pos += size;
+        ok = true;
+    }
+
+    xt_wsr_ps( ps );
+    return ok;
 }
 
 
+// format a record.  each conversion in the format takes the next argument
 void
-LogToHtml( std::function<void( char const * )> htmlOut )
+LogRender( char const *format, uint8 const *args, uint argsSize, StringBuffer &sb )
 {
-    StringBuffer    sb( htmlOut );
-    uint            index   = g_logTail + 1;
+    uint    arg = 0;
 
-    while( index != g_logTail )
+    for ( char const *txt = format; *txt; ++txt )
     {
-        char    c = g_log[ index ];
-        
-        index += 1;
-        if ( index >= countof(g_log) )
+        if ( (*txt != '%') || (txt[1] == '%') )
         {
-            index = 0;
+            txt += ( *txt == '%' );
+            sb.Add( *txt );
+            continue;
         }
 
-        if ( c == '\n' )
+        // the whole conversion spec. e.g., "%-3d"
+        char        spec[ 16 ];
+        uint        length = 1;
+
+        while ( (txt[length]) && (!strchr( "diouxXcsfeEgGp", txt[length] )) && (length < sizeof(spec) - 2) )
         {
-            break;
+            length += 1;
         }
-    }
+        memcpy( spec, txt, length + 1 );
+        spec[ length + 1 ] = 0;
+        txt += length;
 
-    while( index != g_logTail )
-    {
-        char    c = g_log[ index ];
+        if ( arg + 1 > argsSize )
+        {
+            sb.Add( "?" );
+            continue;
+        }
 
-        if ( c != '\n' )
+        switch ( args[ arg ] )
         {
-            sb.Add( c );
+        case LogArgs::Word:
+        {
+            uint32  value;
+
+            memcpy( &value, args + arg + 1, sizeof(value) );
+            arg += 1 + sizeof(value);
+            if ( *txt == 's' )
+            {
+                sb.Add( "?" );
+            }
+            else
+            {
+                sb.AddF( spec, value );
+            }
+            break;
         }
-        else
+
+        case LogArgs::Float:
         {
-            sb.Add( "<br>" );
+            float   value;
+
+            memcpy( &value, args + arg + 1, sizeof(value) );
+            arg += 1 + sizeof(value);
+
+            // String() makes the digits, at the spec's precision (6 like printf if none).  it has
+            // no exponent forms
+            if ( *txt != 'f' )
+            {
+                sb.Add( "?" );
+                break;
+            }
+
+            char const    * dot         = strchr( spec, '.' );
+            const uint      precision   = dot ? atoi( dot + 1 ) : 6;
+            char            textSpec[ sizeof(spec) ];
+            uint            length      = 0;
+            char const    * p           = spec + 1;
+
+            // keep '-' and the width.  the other flags don't apply to text
+            textSpec[ length++ ] = '%';
+            for ( ; (*p) && (strchr( "-+ #0", *p )); ++p )
+            {
+                if ( *p == '-' )
+                {
+                    textSpec[ length++ ] = *p;
+                }
+            }
+            for ( ; isdigit( (unsigned char) *p ); ++p )
+            {
+                textSpec[ length++ ] = *p;
+            }
+            textSpec[ length++ ] = 's';
+            textSpec[ length ] = 0;
+
+            sb.AddF( textSpec, String( value, precision ).c_str() );
+            break;
         }
 
-        index += 1;
-        if ( index >= countof(g_log) )
+        case LogArgs::Str:
         {
-            index = 0;
+            char    str[ LogArgs::k_maxString + 1 ];
+            uint    strLength = args[ arg + 1 ];
+
+            memcpy( str, args + arg + 2, strLength );
+            str[ strLength ] = 0;
+            arg += 2 + strLength;
+            sb.AddF( (*txt == 's') ? spec : "%s", str );
+            break;
+        }
+
+        default:
+            arg = argsSize;
+            sb.Add( "?" );
+            break;
         }
     }
 }
 
+
+void
+LogDrain()
+{
+    StringBuffer    sb( []( char const *txt ) { OutStr( txt ); } );
+    char const    * format;
+    uint8           args[ LogArgs::k_maxSize ];
+    uint            argsSize;
+
+    for ( uint count = 0; (count < LOG_DRAIN_RECORDS) && (CopyRecord( g_drained, format, args, argsSize )); ++count )
+    {
+        LogRender( format, args, argsSize, sb );
+    }
+}
+
+
+void
+LogToHtml( std::function<void( char const * )> htmlOut )
+{
+    StringBuffer    sb( htmlOut );
+    StringBuffer    line(
+        [&sb]( char const *txt )
+        {
+            for ( ; *txt; ++txt )
+            {
+                if ( *txt != '\n' )
+                {
+                    sb.Add( *txt );
+                }
+                else
+                {
+                    sb.Add( "<br>" );
+                }
+            }
+        } );
+    uint32          pos     = g_oldest;
+    char const    * format;
+    uint8           args[ LogArgs::k_maxSize ];
+    uint            argsSize;
+
+    while ( CopyRecord( pos, format, args, argsSize ) )
+    {
+        LogRender( format, args, argsSize, line );
+    }
+    line.Flush();
+}
+
+
+String
+LogStats()
+{
+    String      str;
+
+    AppendF( str, "%d records, %d in the ring, %d not sent", g_records, g_head - g_oldest, g_undrained );
+    return str;
+}
@@ -1,6 +1,8 @@
 /*
  * Log.h
- *  Debugging
+ *  Debugging.  Log() only records the format string (pointer) and its raw arguments
+ *  in a binary ring.  The text is formatted later, when the log is shown or drained
+ *  to the serial port in idle time.  So the format string must be a literal.
  *
  * Author: Ken Reneris <https://github.com/KenReneris>
  * MIT License
@@ -8,6 +10,69 @@
  */
 
 
-void    Log( char const *format, ... );
+// encodes Log() arguments.  a tag byte then the value
+class LogArgs
+{
+public:
+    static const uint   k_maxSize   = 96;       // bytes of encoded arguments per record
+    static const uint   k_maxString = 40;       // %s arguments are copied, and truncated to this
+
+    enum Tag : uint8
+    {
+        Word    = 'w',                          // 32 bits.  any integer or enum
+        Float   = 'f',                          // float
+        Str     = 's',                          // length byte then the characters
+    };
+
+public:
+    LogArgs();
+
+    uint8 const   * Data() const;
+    uint            Size() const;
+
+    void            Add() {}
+
+    template<typename T, typename... Rest>
+    void
+    Add( T const &arg, Rest const &... rest )
+    {
+        Put( arg );
+        Add( rest... );
+    }
+
+private:
+    template<typename T>
+    typename std::enable_if< std::is_integral<T>::value || std::is_enum<T>::value >::type
+    Put( T value )
+    {
+        static_assert( sizeof(T) <= sizeof(uint32), "Log() arguments are 32 bits" );
+        PutWord( uint32(value) );
+    }
+
+    void            Put( char const *str );
+    void            Put( String const &str );
+    void            Put( double value );
+    void            PutWord( uint32 value );
+
+private:
+    uint8           _size;
+    uint8           _data[ k_maxSize ];
+};
+
+
+void    LogRecord( char const *format, LogArgs const &args );
+void    LogRender( char const *format, uint8 const *args, uint argsSize, StringBuffer &sb );
+void    LogDrain();                                     // idle time.  send new records to the serial port
 void    LogToHtml( std::function<void( char const * )> htmlOut );
+String  LogStats();
+
+
+template<typename... Args>
+void
+Log( char const *format, Args const &... args )
+{
+    LogArgs     encoded;
 
+    encoded.Add( args... );
+    LogRecord( format, encoded );
+}
@@ -11,16 +11,65 @@
 #include "platform.h"
 #include <WiFiUdp.h>              
 #include "NtpClient.h"
+#include "FlightRecorder.h"
 
 #define SEVENZYYEARS                2208988800UL
 #define NTP_PACKET_SIZE             48
 #define NTP_DEFAULT_LOCAL_PORT      1337
 #define MAX_NTP_RATE                10              // 10 minutes
+#define NTP_REQUEST_SPACING_MS      50              // min between sends of a burst.  (a reply usually takes longer, so the next request goes as it arrives)
+#define NTP_REQUEST_TIMEOUT_MS      1500            // give up on a request (and move on to the next)
+#define NTP_SELECT_SLOP_MS          20              // added to a samples +/- delay/2 error bounds when finding agreement
 
 
 static WiFiUDP                      g_ntpUdp;
 
 
+static uint32
+Read32( byte const *buffer )
+{
+    return ( (uint32(buffer[0]) << 24) | (uint32(buffer[1]) << 16) | (uint32(buffer[2]) << 8) | buffer[3] );
+}
+
+
+static uint64
+Read64( byte const *buffer )
+{
+    return ( (uint64( Read32(buffer) ) << 32) | Read32(buffer + 4) );
+}
+
+
+static void
+Write32( byte *buffer, uint32 value )
+{
+    buffer[ 0 ] = byte( value >> 24 );
+    buffer[ 1 ] = byte( value >> 16 );
+    buffer[ 2 ] = byte( value >> 8 );
+    buffer[ 3 ] = byte( value );
+}
+
+
+// ntp timestamp (seconds since 1900 . 32bit fraction) to gmt ms since 1970
+static uint64
+NtpToMs( uint64 ntp )
+{
+    const uint32    secs        = uint32( ntp >> 32 ) - SEVENZYYEARS;
+    const uint32    fraction    = uint32( ntp );
+
+    return ( uint64(secs) * 1000 + ((uint64(fraction) * 1000) >> 32) );
+}
+
+
+static uint64
+MsToNtp( uint64 ms )
+{
+    const uint32    secs        = uint32( ms / 1000 ) + SEVENZYYEARS;
+    const uint32    fraction    = uint32( ((ms % 1000) << 32) / 1000 );
+
+    return ( (uint64(secs) << 32) | fraction );
+}
+
+
 void
 NtpClient::Setup()
 {
@@ -48,10 +97,24 @@ NtpClient::GetState() const
 }
 
 
+bool
+NtpClient::IsAwaiting() const
+{
+    return ( (_state == WaitingForResponse) && _awaiting );
+}
+
+
 char const * 
 NtpClient::GetStateStr() const
 {
-    switch( _state )
+    return StateStr( _state );
+}
+
+
+char const *
+NtpClient::StateStr( State state )
+{
+    switch( state )
     {
     case WaitingForWifi:            return "WaitingForWifi";
     case WaitingForSyncTime:        return "WaitingForSyncTime";
@@ -63,6 +126,30 @@ NtpClient::GetStateStr() const
 }
 
 
+int32
+NtpClient::LastOffset() const
+{
+    return _offsetMs;
+}
+
+
+int32
+NtpClient::LastDelay() const
+{
+    return _delayMs;
+}
+
+
+String
+NtpClient::LastSelect() const
+{
+    String      str;
+
+    AppendF( str, "%d of %d", _selected, _replied );
+    return str;
+}
+
+
 String
 NtpClient::LastSync() const
 {
@@ -83,7 +170,9 @@ NtpClient::SendNtpPacket()
     byte    packetBuffer[ NTP_PACKET_SIZE ];
     int     result;
 
-    Out( "Ntp: Send Requesst\n" );
+    Server const  & server = _servers[ _request % _serverCount ];
+
+    Out( "Ntp: Send Request %d to %s\n", _request, server._name );
 
     // if there was a previous timeout there could be an old packet waiting
     int cb = g_ntpUdp.parsePacket();
@@ -106,19 +195,68 @@ NtpClient::SendNtpPacket()
     packetBuffer[ 14 ] = 49;
     packetBuffer[ 15 ] = 52;
 
+    // T1. our time goes in the transmit timestamp.  the server returns it as the originate timestamp
+    UpdateTime();
+    _t1Ms = GmtTimeAsMs();
+    _originate = MsToNtp( _t1Ms );
+    Write32( packetBuffer + 40, uint32(_originate >> 32) );
+    Write32( packetBuffer + 44, uint32(_originate) );
+
     // all NTP fields have been given values, now
     // you can send a packet requesting a timestamp:
-    g_ntpUdp.beginPacket( g_options._ntpServer, 123 );          // NTP requests are to port 123
+    g_ntpUdp.beginPacket( server._name, 123 );          // NTP requests are to port 123
     g_ntpUdp.write( packetBuffer, NTP_PACKET_SIZE );
     result = g_ntpUdp.endPacket();
-    if ( result )
+
+    // a failed send just counts as a timed out request
+    _sentMs = g_ms;
+    _awaiting = ( result != 0 );
+}
+
+
+void
+NtpClient::StartBurst()
+{
+    char const    * name = g_options._ntpServer;
+    char const    * end  = name + strnlen( g_options._ntpServer, sizeof(g_options._ntpServer) );
+
+    // split the server list
+    _serverCount = 0;
+    while ( (name < end) && (_serverCount < k_maxServers) )
     {
-        SetState( WaitingForResponse );
+        uint    length = 0;
+
+        while ( (name < end) && ((*name == ' ') || (*name == ',')) )
+        {
+            name += 1;
+        }
+
+        while ( (name + length < end) && (name[length] != ' ') && (name[length] != ',') )
+        {
+            length += 1;
+        }
+
+        if ( length )
+        {
+            Server    & server = _servers[ _serverCount++ ];
+
+            memcpy( server._name, name, length );
+            server._name[ length ] = 0;
+            server._count = 0;
+        }
+        name += length;
     }
-    else
+
+    if ( !_serverCount )
     {
+        Out( "Ntp: no server\n" );
         SetState( WaitingForRetry );
+        return;
     }
+
+    _request = 0;
+    SetState( WaitingForResponse );
+    SendNtpPacket();
 }
 
 
@@ -130,7 +268,7 @@ NtpClient::Loop()
     case WaitingForWifi:
         if ( g_wifiIsConnected )
         {
-            SendNtpPacket();
+            StartBurst();
         }
         break;
 
@@ -140,7 +278,7 @@ NtpClient::Loop()
         {
             if ( g_wifiIsConnected )
             {
-                SendNtpPacket();
+                StartBurst();
             }
             else
             {
@@ -150,7 +288,22 @@ NtpClient::Loop()
         break;
 
     case WaitingForResponse:
-        CheckForResponse();
+        if ( _awaiting )
+        {
+            CheckForResponse();
+        }
+        else if ( g_ms - _sentMs >= NTP_REQUEST_SPACING_MS )
+        {
+            _request += 1;
+            if ( _request < _serverCount * k_burstSamples )
+            {
+                SendNtpPacket();
+            }
+            else
+            {
+                FinishBurst();
+            }
+        }
         break;
     }
 }
@@ -165,41 +318,181 @@ NtpClient::CheckForResponse()
 
     if ( cb != NTP_PACKET_SIZE ) 
     {
-        if ( g_poweredOnTime > _nextTime )
+        if ( g_ms - _sentMs >= NTP_REQUEST_TIMEOUT_MS )
         {
             Out( "Ntp: response timeout\n" );
-            SetState( WaitingForRetry );
+            _awaiting = false;
         }
     }
     else
     {
         byte    packetBuffer[ NTP_PACKET_SIZE ];
 
+        // T4. as close to the packet being noticed as possible
+        UpdateTime();
+        const uint64    t4 = GmtTimeAsMs();
+
         g_ntpUdp.read( packetBuffer, NTP_PACKET_SIZE );
 
-        auto read32 =
-            []( byte *buffer ) -> uint32
-            {
-                uint32  highWord = word( buffer[0], buffer[1] );
-                uint32  lowWord = word( buffer[2], buffer[3] );
+        // must be the reply to our request (not a late reply to an earlier one), and from a synchronized server
+        const uint8     leap    = ( packetBuffer[0] >> 6 );
+        const uint8     stratum = packetBuffer[ 1 ];
+
+        if ( (Read64( packetBuffer + 24 ) != _originate) || (leap == 3) || (stratum == 0) )
+        {
+            Out( "Ntp: ignoring response (li %d, stratum %d)\n", leap, stratum );
+            return;
+        }
+
+        // 32-39 is the server receive time (T2).  40-47 is the server transmit time (T3)
+        const uint64    t1      = _t1Ms;
+        const uint64    t2      = NtpToMs( Read64( packetBuffer + 32 ) );
+        const uint64    t3      = NtpToMs( Read64( packetBuffer + 40 ) );
+        Server        & server  = _servers[ _request % _serverCount ];
+        Sample        & sample  = server._samples[ server._count++ ];
+
+        // rfc 5905
+        sample._offsetMs = ( int64(t2 - t1) + int64(t3 - t4) ) / 2;
+        sample._delayMs  = int32( int64(t4 - t1) - int64(t3 - t2) );
+        sample._slewTotal = SlewTotal();
+        _awaiting = false;
+    }
+}
+
+
+// the sample with the lowest delay has the least room for an asymmetric path to skew the offset
+bool
+NtpClient::ClockFilter( Server const &server, Sample &best ) const
+{
+    bool    found = false;
+
+    for ( uint index = 0; index < server._count; ++index )
+    {
+        Sample const  & sample = server._samples[ index ];
+
+        if ( (sample._delayMs >= 0) && ((!found) || (sample._delayMs < best._delayMs)) )
+        {
+            best = sample;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+
+void
+NtpClient::FinishBurst()
+{
+    Sample      best[ k_maxServers ];
+    uint        count       = 0;
+    uint        bestVotes   = 0;
+    uint        peer        = 0;
+
+    // each sample is against our clock as of its T4.  the burst takes seconds and a slew runs at
+    // up to 5%, so take out what's been slewed in since.  (then they're all against the clock now)
+    UpdateTime();
+    for ( uint index = 0; index < _serverCount; ++index )
+    {
+        Server    & server = _servers[ index ];
+
+        for ( uint sample = 0; sample < server._count; ++sample )
+        {
+            server._samples[ sample ]._offsetMs -= SlewTotal() - server._samples[ sample ]._slewTotal;
+            server._samples[ sample ]._slewTotal = SlewTotal();
+        }
+    }
 
-                return ( (highWord << 16) | lowWord );
-            };
+    for ( uint index = 0; index < _serverCount; ++index )
+    {
+        if ( ClockFilter( _servers[index], best[count] ) )
+        {
+            Out( "Ntp: %s offset %d, delay %d\n", _servers[index]._name, int32(best[count]._offsetMs), best[count]._delayMs );
+            count += 1;
+        }
+    }
+
+    if ( !count )
+    {
+        SetState( WaitingForRetry );
+        return;
+    }
+
+    // each sample's offset is good to +/- delay/2.  find the server whose offset falls within the
+    // most of the others bounds.  (a tiny marzullo)
+    auto agrees =
+        []( Sample const &sample, int64 offsetMs ) -> bool
+        {
+            const int64     bound   = ( sample._delayMs / 2 ) + NTP_SELECT_SLOP_MS;
+            const int64     diff    = ( offsetMs - sample._offsetMs );
+
+            return ( ABS(diff) <= bound );
+        };
 
-        // 40-43 is transmit time
-        uint32  secsSince1900 = read32( packetBuffer + 40 );
-        uint32  ntpTime = secsSince1900 - SEVENZYYEARS;
+    for ( uint candidate = 0; candidate < count; ++candidate )
+    {
+        uint    votes = 0;
 
-        // 44-47 is fraction of time. e.g., 1/2^32 of a second.
-        uint32  fraction = read32( packetBuffer + 44 );
-        uint32  ms = fraction / 4294968;        // 0..999
+        for ( uint index = 0; index < count; ++index )
+        {
+            votes += agrees( best[index], best[candidate]._offsetMs );
+        }
 
-        //
-        _lastSync = g_poweredOnTime;
-        _lastSyncHadDiff = SetNtpTime( ntpTime, ms );
-        g_globalColor.ClearState( GlobalColor::TimeNotSet );
-        SetState( WaitingForSyncTime );
+        if ( votes > bestVotes )
+        {
+            bestVotes = votes;
+            peer = candidate;
+        }
     }
+
+    // with a majority, use the lowest delay of those in agreement (the falsetickers are left out).
+    // without one (e.g., 2 servers that disagree) there's nothing to go on but delay
+    _selected = 0;
+    if ( bestVotes * 2 > count )
+    {
+        const int64     majority = best[ peer ]._offsetMs;
+
+        for ( uint index = 0; index < count; ++index )
+        {
+            if ( agrees( best[index], majority ) )
+            {
+                _selected += 1;
+                if ( best[index]._delayMs < best[peer]._delayMs )
+                {
+                    peer = index;
+                }
+            }
+        }
+    }
+    else
+    {
+        Out( "Ntp: no majority\n" );
+        for ( uint index = 0; index < count; ++index )
+        {
+            if ( best[index]._delayMs < best[peer]._delayMs )
+            {
+                peer = index;
+            }
+        }
+        _selected = 1;
+    }
+    _replied = count;
+
+    // offsets are against our clock, so apply it to the time now.  (less any slew since)
+    UpdateTime();
+
+    const int64     offsetMs    = best[ peer ]._offsetMs - ( SlewTotal() - best[ peer ]._slewTotal );
+    const uint64    ntpMs       = GmtTimeAsMs() + offsetMs;
+
+    _offsetMs = int32( constrain( offsetMs, int64(INT32_MIN), int64(INT32_MAX) ) );     // first sync can be decades
+    _delayMs  = best[ peer ]._delayMs;
+    Out( "Ntp: offset %d, delay %d (%s)\n", _offsetMs, _delayMs, LastSelect().c_str() );
+
+    //
+    _lastSync = g_poweredOnTime;
+    _lastSyncHadDiff = SetNtpTime( time_t(ntpMs / 1000), uint32(ntpMs % 1000) );
+    g_globalColor.ClearState( GlobalColor::TimeNotSet );
+    SetState( WaitingForSyncTime );
 }
 
 
@@ -223,6 +516,7 @@ NtpClient::SetState( State state )
     // new state
     _state = state;
     Out( "Ntp: %s\n", GetStateStr() );
+    g_flightRecorder.State( FlightRecorder::Kind::NtpState, state );
     switch ( state )
     {
     case WaitingForWifi:
@@ -234,7 +528,6 @@ NtpClient::SetState( State state )
 
     case WaitingForResponse:
         g_globalColor.EnableState( GlobalColor::SyncingNtpTime );
-        _nextTime = g_poweredOnTime + 2;
         break;
 
     case WaitingForRetry:
@@ -1,6 +1,8 @@
 /*
  * NtpClient.h
- *  Async ntp client.
+ *  Async ntp client.  Each sync is a burst of requests round-robin across the configured
+ *  servers.  The lowest delay sample of each server is kept and servers that disagree with
+ *  the majority are dropped before the time is set.
  *
  * Author: Ken Reneris <https://github.com/KenReneris>
  * MIT License
@@ -10,12 +12,16 @@
 
 class NtpClient
 {
+public:
+    static const uint   k_maxServers    = 3;    // servers listed in g_options._ntpServer (space or comma separated)
+    static const uint   k_burstSamples  = 4;    // requests per server per sync
+
 public:
     enum State : uint8
     {
         WaitingForWifi,                     // waiting for wifi status to be online
         WaitingForSyncTime,                 // normal / idle
-        WaitingForResponse,                 // sent request for time
+        WaitingForResponse,                 // sending the burst of requests for time
         WaitingForRetry                     // request failed..  waiting to retry
     };
 
@@ -26,19 +32,54 @@ public:
 
     void            ForceSync();
     String          LastSync() const;
+    int32           LastOffset() const;     // ms.  server time - our time (as of the last sync)
+    int32           LastDelay() const;      // ms.  network round trip (as of the last sync)
+    String          LastSelect() const;     // servers used / servers that replied (as of the last sync)
     State           GetState() const;
+    bool            IsAwaiting() const;     // a request is out and its response not yet seen
     char const    * GetStateStr() const;
 
+    static char const * StateStr( State state );
+
+private:
+    struct Sample
+    {
+        int64           _offsetMs;              // server time - our time
+        int32           _delayMs;               // round trip
+        int32           _slewTotal;             // SlewTotal() at T4.  the slew applied since has to come out of _offsetMs
+    };
+
+    struct Server
+    {
+        char            _name[ sizeof(g_options._ntpServer) ];
+        uint8           _count;                 // valid entries in _samples
+        Sample          _samples[ k_burstSamples ];
+    };
+
 private:
     void            SetState( State state );
+    void            StartBurst();
     void            SendNtpPacket();
     void            CheckForResponse();
+    void            FinishBurst();
+    bool            ClockFilter( Server const &server, Sample &best ) const;
     
 private:
     State           _state;
     bool            _lastSyncHadDiff;       // true if the last sync updated the time.  this forces the next sync to be quick (in 10m)
     uint32          _lastSync;              // last time synced
     uint32          _nextTime;              // the next time to start a sync
+    uint64          _originate;             // ntp timestamp sent as the transmit time (server echos it back)
+    uint64          _t1Ms;                  // our gmt ms when the request was sent
+    int32           _offsetMs;              // last computed offset
+    int32           _delayMs;               // last computed round trip delay
+    uint8           _serverCount;           // entries in _servers
+    uint8           _request;               // request # in the burst.  sent to _servers[ _request % _serverCount ]
+    bool            _awaiting;              // _request has been sent and its response not yet seen
+    uint32          _sentMs;                // g_ms when _request was sent
+    uint8           _replied;               // servers that replied (last sync)
+    uint8           _selected;              // servers that agreed with the majority (last sync)
+    Server          _servers[ k_maxServers ];
 };
 
 extern NtpClient    g_ntp;
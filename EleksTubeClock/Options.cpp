@@ -8,59 +8,320 @@
  */
 
 #include "platform.h"
+#include "SettingsStore.h"
 #include <EEPROM.h>
 
-#define VERSION     1
+#define VERSION             1           // of the pre-SettingsStore eeprom image.  only read to migrate it
+#define LEGACY_EEPROM_SIZE  512
+#define LEGACY_MAX_PPB      500000      // a migrated micro adjust rate is clamped to this.  (Time.cpp's MADJ_MAX_PPB)
+#define SAVE_SETTLE_MS      2000        // edits closer together than this are coalesced into one write
+#define SAVE_MAX_MS         30000       // but a change is never held longer than this
+
+// each persisted field is its own key in the SettingsStore.  keys are forever.  a
+// new field gets a new key and a field that changes size gets a new key.
+// (Options isn't standard-layout because of the OnOff base class, gcc's offsetof is fine with that)
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#define FIELD( key, member )    { SettingsStore::k_keyOptions + (key), uint16( offsetof(Options, member) ), uint16( sizeof(Options::member) ) }
+
+static const struct
+{
+    uint16      _key;
+    uint16      _offset;
+    uint16      _size;
+} k_fields[] =
+{
+    FIELD(  0, _prefixName ),
+    FIELD(  1, _ssid ),
+    FIELD(  2, _password ),
+    FIELD(  3, _splashScreen ),
+    FIELD(  4, _surpressLeadingZero ),
+    FIELD(  5, _timeOnOff ),
+    FIELD(  6, _dimOnOff ),
+    FIELD(  7, _12Hour ),
+    FIELD(  8, _bright ),
+    FIELD(  9, _dim ),
+    FIELD( 10, _topOfHour ),
+    FIELD( 11, _quarterOfHour ),
+    FIELD( 12, _ntpServer ),
+    FIELD( 13, _ntpColor ),
+    FIELD( 14, _ntpSync ),
+    FIELD( 15, _ntpFrequency ),
+    FIELD( 16, _madjEnable ),
+    FIELD( 17, _madjPpb ),
+    FIELD( 18, _slewMaxMs ),
+    FIELD( 19, _dateColor ),
+    FIELD( 20, _dateMinutes ),
+    FIELD( 21, _dateSecond ),
+    FIELD( 22, _dateMmddyy ),
+    FIELD( 23, _tzKey ),
+    FIELD( 24, _tzColor ),
+    FIELD( 25, _gmtOffset ),
+    FIELD( 26, _httpClient ),
+    FIELD( 27, _accessPointLifespan ),
+    FIELD( 28, _allowPopupUrl ),
+    FIELD( 29, _allowBrightnessUrl ),
+};
+
+// the eeprom image as the last release (VERSION 1) saved it.  (only read to migrate it)
+struct LegacyOptions
+{
+    uint32              _checksum;
+    uint8               _version;
+    bool                _dirty;
+
+    char                _prefixName[ 10 ];
+    char                _ssid[ 32 ];
+    char                _password[ 16 ];
+    bool                _splashScreen;
+    bool                _surpressLeadingZero;
+
+    TimeOnOff           _timeOnOff;
+    DimOnOff            _dimOnOff;
+    bool                _12Hour;
+    uint8               _bright;
+    uint8               _dim;
+
+    ARGB                _topOfHour;
+    ARGB                _quarterOfHour;
+
+    char                _ntpServer[ 32 ];
+    ARGB                _ntpColor;
+    HourMinute          _ntpSync;
+    uint8               _ntpFrequency;
+
+    bool                _madjEnable;
+    int8                _madjDir;               // micro adjust +1 or -1 a millisecond
+    uint32              _madjFreq;              // every this many elapsed ms
+    Smooth<4>           _madjSmooth;
+
+    ARGB                _dateColor;
+    uint8               _dateMinutes;
+    uint8               _dateSecond;
+    bool                _dateMmddyy;
+
+    char                _tzKey[ 16 ];
+    ARGB                _tzColor;
+    int32               _gmtOffset;
+
+    ARGB                _httpClient;
+    uint8               _accessPointLifespan;
+    bool                _allowPopupUrl;
+    bool                _allowBrightnessUrl;
+
+    uint32              Checksum();
+};
+
+#define LEGACY_COPY( member )   static_assert( sizeof(Options::member) == sizeof(LegacyOptions::member), #member " changed size" ); \
+                                memcpy( &member, &legacy.member, sizeof(member) )
+
+static Options      g_savedOptions;         // the values in the SettingsStore
+static uint32       g_dirtyAt;              // g_ms when _dirty was set
+static uint32       g_editedAt;             // g_ms of the last SaveSoon()
+
 
 void
 Options::Setup()
 {
-    EEPROM.begin( 512 );        // Initialize EEPROM
+    g_settings.Setup();
+}
+
+
+// reads from the old eeprom layout (to migrate it)
+bool
+Options::LegacyRead( uint offset, void *data, uint size )
+{
+    uint8   * const start = (uint8 *) data;
+
+    if ( offset + size > LEGACY_EEPROM_SIZE )
+    {
+        return false;
+    }
+
+    EEPROM.begin( LEGACY_EEPROM_SIZE );
+    for ( uint pos = 0; pos < size; ++pos )
+    {
+        start[ pos ] = EEPROM.read( offset + pos );
+    }
+    EEPROM.end();
+
+    return true;
 }
 
 
 void
 Options::Load()
 {
-    uint8   * const start   = (uint8 *) this;
+    // g_savedOptions is what the store holds.  defaults for keys never written
+    Defaults();
+    g_savedOptions.Defaults();
 
-    for( int pos=0; pos < sizeof(*this); ++pos )
+    if ( !g_settings.IsEmpty() )
     {
-        start[ pos ] = EEPROM.read( pos );
+        g_settings.Load(
+            [this]( uint16 key, void const *data, uint16 length )
+            {
+                for ( auto const &field : k_fields )
+                {
+                    if ( (field._key == key) && (field._size == length) )
+                    {
+                        memcpy( ((uint8 *) this) + field._offset, data, length );
+                    }
+                }
+            } );
+        g_savedOptions = *this;
+    }
+    else if ( Migrate() )
+    {
+        Out( "Options: migrate from eeprom\n" );
+        Save();
+    }
+    else
+    {
+        Defaults();
     }
-    _tzKey[ countof(_tzKey)-1 ] = 0;
 
-    if ( (_checksum != Checksum()) || (_version != VERSION) || (!_dateMinutes) || (!_ntpFrequency) )
+    _dirty = false;
+    _tzKey[ countof(_tzKey)-1 ] = 0;
+    if ( (!_dateMinutes) || (!_ntpFrequency) )
     {
         Reset();
     }
 }
 
 
+// copy the settings out of the old eeprom image.  fields it didn't have keep their defaults
+bool
+Options::Migrate()
+{
+    LegacyOptions   legacy;
+
+    if ( (!LegacyRead( 0, &legacy, sizeof(legacy) )) || (legacy._checksum != legacy.Checksum()) || (legacy._version != VERSION) )
+    {
+        return false;
+    }
+
+    LEGACY_COPY( _prefixName );
+    LEGACY_COPY( _ssid );
+    LEGACY_COPY( _password );
+    LEGACY_COPY( _splashScreen );
+    LEGACY_COPY( _surpressLeadingZero );
+    LEGACY_COPY( _timeOnOff );
+    LEGACY_COPY( _dimOnOff );
+    LEGACY_COPY( _12Hour );
+    LEGACY_COPY( _bright );
+    LEGACY_COPY( _dim );
+    LEGACY_COPY( _topOfHour );
+    LEGACY_COPY( _quarterOfHour );
+    LEGACY_COPY( _ntpServer );
+    LEGACY_COPY( _ntpColor );
+    LEGACY_COPY( _ntpSync );
+    LEGACY_COPY( _ntpFrequency );
+    LEGACY_COPY( _madjEnable );
+    LEGACY_COPY( _dateColor );
+    LEGACY_COPY( _dateMinutes );
+    LEGACY_COPY( _dateSecond );
+    LEGACY_COPY( _dateMmddyy );
+    LEGACY_COPY( _tzKey );
+    LEGACY_COPY( _tzColor );
+    LEGACY_COPY( _gmtOffset );
+    LEGACY_COPY( _httpClient );
+    LEGACY_COPY( _accessPointLifespan );
+    LEGACY_COPY( _allowPopupUrl );
+    LEGACY_COPY( _allowBrightnessUrl );
+
+    // +/-1ms every _madjFreq ms is 1e9/_madjFreq ppb
+    if ( legacy._madjFreq )
+    {
+        const int64     ppb = int64( legacy._madjDir < 0 ? -1 : 1 ) * ( 1000000000LL / legacy._madjFreq );
+
+        _madjPpb = int32( constrain( ppb, -int64(LEGACY_MAX_PPB), int64(LEGACY_MAX_PPB) ) );
+    }
+
+    return true;
+}
+
+
 void
 Options::Save()
 {
-    uint8   * const start = (uint8 *) this;
+    Write();
+    UpdateWaitTimes();
+}
 
-    Out( "Options: Save\n" );
-    _checksum = Checksum();
-    _dirty = false;
-    for (int pos = 0; pos < sizeof(*this); ++pos)
+
+void
+Options::SaveSoon()
+{
+    if ( !_dirty )
     {
-        EEPROM.write( pos, start[pos] );
+        _dirty = true;
+        g_dirtyAt = g_ms;
     }
-    EEPROM.commit();
+    g_editedAt = g_ms;
+
+    // the new settings take effect now.  it's only the write that waits
     UpdateWaitTimes();
 }
 
 
+void
+Options::Loop()
+{
+    if ( (_dirty) && ((g_ms - g_editedAt >= SAVE_SETTLE_MS) || (g_ms - g_dirtyAt >= SAVE_MAX_MS)) )
+    {
+        Write();
+    }
+}
+
+
+void
+Options::Flush()
+{
+    if ( _dirty )
+    {
+        Write();
+    }
+}
+
+
+// only the fields that changed are appended to the store
+void
+Options::Write()
+{
+    uint8 const   * const start = (uint8 const *) this;
+    uint8         * const saved = (uint8 *) &g_savedOptions;
+    uint                  count = 0;
+
+    for ( auto const &field : k_fields )
+    {
+        if ( memcmp( start + field._offset, saved + field._offset, field._size ) )
+        {
+            if ( g_settings.Append( field._key, start + field._offset, field._size ) )
+            {
+                memcpy( saved + field._offset, start + field._offset, field._size );
+                count += 1;
+            }
+        }
+    }
+
+    Out( "Options: Save %d\n", count );
+    _dirty = false;
+}
+
+
 void
 Options::Reset()
 {
     Out( "Options: Reset\n" );
-    memset( this, 0, sizeof(*this) );
+    Defaults();
+    Save();
+}
 
-    _version                = VERSION;
+
+void
+Options::Defaults()
+{
+    memset( this, 0, sizeof(*this) );
 
     strcpy( _ssid,      "EleksTube" );
     strcpy( _ntpServer, "time.google.com" );
@@ -85,6 +346,7 @@ Options::Reset()
     _ntpFrequency           = 144;                                                  // daily
 
     _madjEnable             = true;
+    _slewMaxMs              = 2000;
 
     _dateColor              = { (ARGB::CrossFade | 3), 0x00, 0xFF, 0x00 };          // green
     _dateMinutes            = 1;
@@ -97,12 +359,11 @@ Options::Reset()
     _accessPointLifespan    = 60;
     _allowPopupUrl          = true;
     _allowBrightnessUrl     = true;
-    Save();
 }
 
 
 uint32
-Options::Checksum()
+LegacyOptions::Checksum()
 {
     uint8   * const start           = (uint8 *) this;
     uint32          checksum        = 0;
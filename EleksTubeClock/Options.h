@@ -1,6 +1,6 @@
 /*
  * Options.h
- *  User options saved to EEPROM.
+ *  User options.  Each field is saved as its own key in the SettingsStore.
  *
  * Author: Ken Reneris <https://github.com/KenReneris>
  * MIT License
@@ -10,9 +10,7 @@
 
 struct Options
 {
-    uint32              _checksum;
-    uint8               _version;               // version of this structure
-    bool                _dirty;                 // for slow updates mark dirty.  only saved when wifi is lost
+    bool                _dirty;                 // changed (SaveSoon()) and not yet written
 
     char                _prefixName[ 10 ];      // webserver decroates page names with this
     char                _ssid[ 32 ];            // the AP name.  defaults to "EleksTube"
@@ -29,15 +27,14 @@ struct Options
     ARGB                _topOfHour;             // Top of hour effect (if any)
     ARGB                _quarterOfHour;         // Quarter of hour effect (in any)
 
-    char                _ntpServer[ 32 ];       // ntp server to use. defauts to "time.google.com"
+    char                _ntpServer[ 32 ];       // ntp server(s) to use.  space or comma separated. defauts to "time.google.com"
     ARGB                _ntpColor;              // effect to use when syncing the ntp time (if any)
     HourMinute          _ntpSync;               // hh:mm to align syncing too
     uint8               _ntpFrequency;          // ntp polling rate in 10 minute increments (aligned to _ntpSync)
 
     bool                _madjEnable;            // if computing micro adjustments of lcoal time-drift are enabled. 
-    int8                _madjDir;               // micro adjust +1 or -1 a millisecond 
-    uint32              _madjFreq;              // micro adjust _madjDir every n elasped ms's
-    Smooth<4>           _madjSmooth;            // smooth out the adjustment rate with a little history
+    int32               _madjPpb;               // frequency correction of the local clock in parts per billion (+ is faster)
+    uint16              _slewMaxMs;             // ntp offsets up to this are slewed out.  larger ones step the time (0 = always step)
 
     ARGB                _dateColor;             // effect when showing the date (if any).  If no effect, showing the date is disabled.
     uint8               _dateMinutes;           // show the date every this many minutes. E.g., 1, 5, 15, ...
@@ -45,7 +42,7 @@ struct Options
     bool                _dateMmddyy;            // use mmddyy or yymmdd format
 
     char                _tzKey[ 16 ];           // lead byte is 0 if disabled.  the users timezonedb.com key
-    ARGB                _tzColor;               // effect when syncing timezone (if any).  Note the timezone sync will cause lag/glitches
+    ARGB                _tzColor;               // effect when syncing timezone (if any)
     int32               _gmtOffset;             // delta from gmtTime.  "g_now = g_gmtTime + _gmtOffset"
 
     ARGB                _httpClient;            // effect when responding to an http request.  note serving web requests will likely cause lag/glitches.
@@ -56,11 +53,18 @@ struct Options
 public:
     void                Setup();
     void                Load();
-    void                Save();
+    void                Save();                 // write the changes now
+    void                SaveSoon();             // the options changed.  Loop() writes them once the edits settle
+    void                Loop();                 // between frames.  writes settled changes
+    void                Flush();                // write any pending changes now (before a reboot)
     void                Reset();
 
 private:
-    uint32              Checksum();
+    void                Write();
+    void                Defaults();
+    bool                Migrate();              // from the old eeprom image
+
+    static bool         LegacyRead( uint offset, void *data, uint size );
 };
 
 
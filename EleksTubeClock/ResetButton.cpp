@@ -56,10 +56,11 @@ ResetButton::FullReset( bool preserveName )
     if ( preserveName )
     {
         strcpy( g_options._prefixName, prefixName );
+        g_options.SaveSoon();
     }
 
     WiFi.disconnect( true );    // clear wifi settings
-    system_restart();
+    Reboot();
     Out( "Reset: Failed?\n" );
     for (; ; );
 }
@@ -0,0 +1,424 @@
+/*
+ * SettingsStore
+ *  Log-structured key/value store in flash.
+ *
+ *  Sector:     SectorHeader, then records until erased (0xFF) flash
+ *  Record:     RecordHeader, then _length bytes of value padded to 4 bytes
+ *
+ *  The store takes the EEPROM sector and the sector(s) before it.  The sketch doesn't
+ *  use a filesystem or OTA so that flash is otherwise unused.
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+#include "platform.h"
+#include "SettingsStore.h"
+
+extern "C" uint32_t _EEPROM_start;
+
+#define SETTINGS_MAGIC          0x31535445      // "ETS1"
+#define SETTINGS_SECTORS        2
+#define COMPACT_PERCENT         75              // Loop() compacts once the active sector is this full (and the display is idle)
+#define COMPACT_FORCE_PERCENT   90              // or this full regardless
+#define ALIGN4(a)               ( ((a) + 3) & ~3 )
+
+
+struct SectorHeader
+{
+    uint32              _magic;
+    uint32              _sequence;
+};
+
+
+struct RecordHeader
+{
+    uint16              _key;
+    uint16              _length;
+    uint32              _crc;                   // of _key, _length and the value
+};
+
+
+class EspFlash : public SettingsFlash
+{
+public:
+    bool
+    Read( uint32 address, uint32 *data, uint32 size ) override
+    {
+        return ESP.flashRead( address, data, size );
+    }
+
+    bool
+    Write( uint32 address, uint32 const *data, uint32 size ) override
+    {
+        return ESP.flashWrite( address, const_cast<uint32 *>( data ), size );
+    }
+
+    bool
+    Erase( uint32 sector ) override
+    {
+        return ESP.flashEraseSector( sector );
+    }
+};
+
+
+static EspFlash         g_espFlash;
+SettingsStore           g_settings( g_espFlash );
+
+
+static uint32
+Crc32( void const *data, uint32 size, uint32 crc )
+{
+    uint8 const   * bytes = (uint8 const *) data;
+
+    while ( size-- )
+    {
+        crc ^= *bytes++;
+        for ( uint bit = 0; bit < 8; ++bit )
+        {
+            crc = ( crc >> 1 ) ^ ( 0xEDB88320 & -(crc & 1) );
+        }
+    }
+
+    return crc;
+}
+
+
+static uint32
+RecordCrc( RecordHeader const &header, void const *value )
+{
+    const uint32    crc = Crc32( &header, offsetof(RecordHeader, _crc), 0xFFFFFFFF );
+
+    return ~Crc32( value, header._length, crc );
+}
+
+
+SettingsStore::SettingsStore( SettingsFlash &flash )
+    : _flash            ( flash )
+    , _firstSector      ( 0 )
+    , _sectors          ( 0 )
+    , _active           ( -1 )
+    , _sequence         ( 0 )
+    , _writeOffset      ( 0 )
+    , _erases           ( 0 )
+{
+}
+
+
+void
+SettingsStore::Setup()
+{
+    const uint32    eepromSector    = ( uint32( uintptr_t(&_EEPROM_start) ) - 0x40200000 ) / k_sectorSize;
+    const uint32    firstSector     = eepromSector - ( SETTINGS_SECTORS - 1 );
+
+    // paranoid.  don't write over the sketch
+    if ( firstSector * k_sectorSize < ESP.getSketchSize() )
+    {
+        Out( "Settings: no room for the store\n" );
+        return;
+    }
+
+    Mount( firstSector, SETTINGS_SECTORS );
+}
+
+
+bool
+SettingsStore::Mount( uint32 firstSector, uint sectors )
+{
+    _firstSector = firstSector;
+    _sectors = sectors;
+    _active = -1;
+
+    // the valid sector with the highest sequence is the active one
+    for ( uint index = 0; index < _sectors; ++index )
+    {
+        SectorHeader    header;
+
+        if ( (_flash.Read( SectorAddress(index), (uint32 *) &header, sizeof(header) )) &&
+             (header._magic == SETTINGS_MAGIC) &&
+             (header._sequence != 0xFFFFFFFF) &&
+             ((_active < 0) || (header._sequence > _sequence)) )
+        {
+            _active = index;
+            _sequence = header._sequence;
+        }
+    }
+
+    if ( _active >= 0 )
+    {
+        _writeOffset = Scan( _active, nullptr );
+        Out( "Settings: %s\n", toString().c_str() );
+    }
+
+    return ( _active >= 0 );
+}
+
+
+void
+SettingsStore::Loop( bool idle )
+{
+    const uint32    percent = ( _writeOffset * 100 ) / k_sectorSize;
+
+    // the erase blocks for a while, so try to do it when it won't show
+    if ( (_active >= 0) && (percent >= (idle ? COMPACT_PERCENT : COMPACT_FORCE_PERCENT)) )
+    {
+        Compact();
+    }
+}
+
+
+bool
+SettingsStore::IsEmpty() const
+{
+    return ( _active < 0 );
+}
+
+
+uint32
+SettingsStore::Erases() const
+{
+    return _erases;
+}
+
+
+String
+SettingsStore::toString() const
+{
+    String      str;
+
+    if ( _active >= 0 )
+    {
+        AppendF( str, "sector %d seq %d, %d of %d bytes, %d erases", _active, _sequence, _writeOffset, k_sectorSize, _erases );
+    }
+    else
+    {
+        AppendF( str, "empty, %d erases", _erases );
+    }
+
+    return str;
+}
+
+
+uint32
+SettingsStore::SectorAddress( uint index ) const
+{
+    return ( (_firstSector + index) * k_sectorSize );
+}
+
+
+uint32
+SettingsStore::Scan( uint index, RecordVisitor visitor ) const
+{
+    const uint32    address = SectorAddress( index );
+    uint32          offset  = sizeof( SectorHeader );
+    uint32          record[ (sizeof(RecordHeader) + k_maxValue) / 4 ];
+    RecordHeader  & header  = *(RecordHeader *) record;
+
+    while ( offset + sizeof(RecordHeader) <= k_sectorSize )
+    {
+        if ( !_flash.Read( address + offset, record, sizeof(RecordHeader) ) )
+        {
+            return k_sectorSize;
+        }
+
+        // erased flash is the end of the log
+        if ( (header._key == 0xFFFF) && (header._length == 0xFFFF) && (header._crc == 0xFFFFFFFF) )
+        {
+            return offset;
+        }
+
+        // anything else that doesn't check out was torn by a reset.  nothing more can be appended
+        // after it, so the sector is treated as full (and will be compacted)
+        const uint32    size = sizeof( RecordHeader ) + ALIGN4( header._length );
+
+        if ( (header._key >= k_maxKeys) || (header._length > k_maxValue) || (offset + size > k_sectorSize) ||
+             (!_flash.Read( address + offset + sizeof(RecordHeader), record + sizeof(RecordHeader)/4, size - sizeof(RecordHeader) )) ||
+             (RecordCrc( header, record + sizeof(RecordHeader)/4 ) != header._crc) )
+        {
+            Out( "Settings: torn record at %d\n", offset );
+            return k_sectorSize;
+        }
+
+        if ( visitor )
+        {
+            visitor( header._key, record, size, offset );
+        }
+        offset += size;
+    }
+
+    return offset;
+}
+
+
+void
+SettingsStore::Load( Visitor visitor ) const
+{
+    if ( _active >= 0 )
+    {
+        Scan( _active,
+            [&visitor]( uint16 key, uint32 const *record, uint32 size, uint32 recordOffset )
+            {
+                RecordHeader const  & header = *(RecordHeader const *) record;
+
+                visitor( key, record + sizeof(RecordHeader)/4, header._length );
+            } );
+    }
+}
+
+
+bool
+SettingsStore::Read( uint16 key, void *data, uint16 length ) const
+{
+    bool    found = false;
+
+    Load(
+        [&]( uint16 recordKey, void const *value, uint16 recordLength )
+        {
+            if ( (recordKey == key) && (recordLength == length) )
+            {
+                memcpy( data, value, length );
+                found = true;
+            }
+        } );
+
+    return found;
+}
+
+
+bool
+SettingsStore::Append( uint16 key, void const *data, uint16 length )
+{
+    uint32          record[ (sizeof(RecordHeader) + k_maxValue) / 4 ];
+    RecordHeader  & header  = *(RecordHeader *) record;
+    const uint32    size    = sizeof( RecordHeader ) + ALIGN4( length );
+
+    if ( (!_sectors) || (key >= k_maxKeys) || (length > k_maxValue) )
+    {
+        return false;
+    }
+
+    if ( (_active < 0) && (!Format( 0, 1 )) )
+    {
+        return false;
+    }
+
+    if ( (_writeOffset + size > k_sectorSize) && ((!Compact()) || (_writeOffset + size > k_sectorSize)) )
+    {
+        Out( "Settings: full\n" );
+        return false;
+    }
+
+    memset( record, 0xFF, size );
+    memcpy( record + sizeof(RecordHeader)/4, data, length );
+    header._key = key;
+    header._length = length;
+    header._crc = RecordCrc( header, data );
+
+    if ( !_flash.Write( SectorAddress(_active) + _writeOffset, record, size ) )
+    {
+        // whatever made it out will read back as torn
+        _writeOffset = k_sectorSize;
+        return false;
+    }
+
+    _writeOffset += size;
+    return true;
+}
+
+
+// copy the last record of each key to the next sector
+bool
+SettingsStore::Compact()
+{
+    uint16          last[ k_maxKeys ];
+    uint16          sizes[ k_maxKeys ];
+    uint32          needed  = sizeof( SectorHeader );
+    const uint      target  = ( _active + 1 ) % _sectors;
+    const uint32    address = SectorAddress( target );
+    uint32          offset  = sizeof( SectorHeader );
+    bool            ok      = true;
+
+    if ( _active < 0 )
+    {
+        return Format( 0, 1 );
+    }
+
+    Out( "Settings: compact %d to %d\n", _active, target );
+
+    memset( last, 0, sizeof(last) );
+    memset( sizes, 0, sizeof(sizes) );
+    Scan( _active,
+        [&last, &sizes]( uint16 key, uint32 const *record, uint32 size, uint32 recordOffset )
+        {
+            last[ key ] = recordOffset;
+            sizes[ key ] = size;
+        } );
+
+    // the live records have to fit.  (the sector after the EEPROM sector is the sdk's rf calibration)
+    for ( uint key = 0; key < k_maxKeys; ++key )
+    {
+        needed += sizes[ key ];
+    }
+
+    if ( needed > k_sectorSize )
+    {
+        Out( "Settings: %d bytes of live records don't fit a sector\n", needed );
+        return false;
+    }
+
+    _erases += 1;
+    if ( !_flash.Erase( _firstSector + target ) )
+    {
+        return false;
+    }
+
+    Scan( _active,
+        [&]( uint16 key, uint32 const *record, uint32 size, uint32 recordOffset )
+        {
+            if ( last[key] == recordOffset )
+            {
+                ok = ok && ( offset + size <= k_sectorSize ) && _flash.Write( address + offset, record, size );
+                offset += size;
+            }
+        } );
+
+    // the header goes last.  until it's written the old sector is still the active one
+    if ( (!ok) || (!WriteHeader( target, _sequence + 1 )) )
+    {
+        return false;
+    }
+
+    _active = target;
+    _sequence += 1;
+    _writeOffset = offset;
+    return true;
+}
+
+
+bool
+SettingsStore::Format( uint index, uint32 sequence )
+{
+    _erases += 1;
+    if ( (!_flash.Erase( _firstSector + index )) || (!WriteHeader( index, sequence )) )
+    {
+        return false;
+    }
+
+    _active = index;
+    _sequence = sequence;
+    _writeOffset = sizeof( SectorHeader );
+    return true;
+}
+
+
+bool
+SettingsStore::WriteHeader( uint index, uint32 sequence )
+{
+    SectorHeader    header;
+
+    header._magic = SETTINGS_MAGIC;
+    header._sequence = sequence;
+
+    return _flash.Write( SectorAddress(index), (uint32 const *) &header, sizeof(header) );
+}
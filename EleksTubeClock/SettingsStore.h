@@ -0,0 +1,74 @@
+/*
+ * SettingsStore.h
+ *  Log-structured key/value store in flash.  Each value is appended as a crc'd record
+ *  to the active sector, so a save only writes what changed and doesn't erase anything.
+ *  When the active sector fills, the latest value of each key is copied to the next
+ *  sector (round-robin) and that sector's header is written last, so a reset part way
+ *  through leaves the old sector in charge.
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+// the flash the store lives in.  (so the store can be run against a simulated flash)
+class SettingsFlash
+{
+public:
+    virtual bool        Read( uint32 address, uint32 *data, uint32 size ) = 0;
+    virtual bool        Write( uint32 address, uint32 const *data, uint32 size ) = 0;    // only clears bits
+    virtual bool        Erase( uint32 sector ) = 0;                                     // sets the sector to 0xFF
+};
+
+
+class SettingsStore
+{
+public:
+    static const uint32     k_sectorSize    = 4096;
+    static const uint16     k_maxKeys       = 64;       // keys are 0 .. k_maxKeys-1
+    static const uint16     k_maxValue      = 64;       // bytes
+    static const uint       k_format        = 1;        // of the records.  (the "ETS1" sector header magic)
+
+    // keys.  Options fields use k_keyOptions + n (see Options.cpp)
+    static const uint16     k_keyOptions    = 1;
+    static const uint16     k_keyDiscipline = 48;       // Time.cpp's clock discipline record
+
+    typedef std::function<void ( uint16 key, void const *data, uint16 length )>   Visitor;
+
+public:
+    SettingsStore( SettingsFlash &flash );
+
+    void                Setup();                        // find the sectors (on the device) and Mount()
+    bool                Mount( uint32 firstSector, uint sectors );
+    void                Loop( bool idle );              // compact in the background.  when the display is idle or the sector is nearly full
+
+    bool                IsEmpty() const;                // no sector has been written yet
+    void                Load( Visitor visitor ) const;  // every record, oldest first (so the last one for a key wins)
+    bool                Read( uint16 key, void *data, uint16 length ) const;
+    bool                Append( uint16 key, void const *data, uint16 length );
+    bool                Compact();
+
+    uint32              Erases() const;
+    String              toString() const;
+
+private:
+    typedef std::function<void ( uint16 key, uint32 const *record, uint32 size, uint32 offset )>    RecordVisitor;
+
+    uint32              SectorAddress( uint index ) const;
+    bool                Format( uint index, uint32 sequence );
+    bool                WriteHeader( uint index, uint32 sequence );
+    uint32              Scan( uint index, RecordVisitor visitor ) const;   // returns the end of the log (k_sectorSize if torn)
+
+private:
+    SettingsFlash     & _flash;
+    uint32              _firstSector;           // flash sector # of _sectors
+    uint8               _sectors;               // 0 if the store is not usable
+    int8                _active;                // index of the active sector (-1 if none)
+    uint32              _sequence;              // sequence # of the active sector.  bumped on every compaction
+    uint32              _writeOffset;           // where the next record goes in the active sector
+    uint32              _erases;                // since boot
+};
+
+
+extern SettingsStore    g_settings;
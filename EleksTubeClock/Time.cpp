@@ -5,6 +5,17 @@
  *  between the deviecs time and the report ntp time in order to reduce the 
  *  drift effects.
  *
+ *  The drift is disciplined with an integer frequency locked loop.  Each ntp sample's
+ *  offset over the interval since the last one is the frequency error (in parts per
+ *  billion) which is folded into g_options._madjPpb with a gain that grows with the
+ *  interval (short intervals are mostly noise).  Offsets up to g_options._slewMaxMs are
+ *  slewed out over the following minutes (the time runs a little fast or slow, so every
+ *  second is still shown once).  Only larger offsets step the time.
+ *
+ *  The discipline state is kept in its own small SettingsStore record so a
+ *  reboot starts with the learned frequency and lock.  It's only written when it
+ *  materially changes, and then at most every few hours, to spare the flash.
+ *
  * Author: Ken Reneris <https://github.com/KenReneris>
  * MIT License
  * ----------------------------------------------------------
@@ -12,20 +23,59 @@
 
 
 #include "platform.h"
+#include "SettingsStore.h"
 
 // positions between counts
 static uint32       g_lastMs;               // last raw ms
 static int32        g_lastPosPowerMs;       // 0..1000 position
 static int32        g_lastPosGmtMs;         // 0..1000 position
-static int32        g_lastPosMadj;          // 0..g_options._madjFreq position
+static int64        g_madjAccum;            // fraction of a ms owed to g_ms, in ms * 1e-9
+static int32        g_slewMs;               // ms still to be added (+) or dropped (-) from the time
+static uint32       g_slewEvery;            // 1ms of g_slewMs is applied every g_slewEvery ms
+static uint32       g_slewPos;              // 0..g_slewEvery position
+static int32        g_slewTotal;            // ms slewed in since boot.  (ntp samples note it, to take out the slew applied after them)
+static int32        g_owedMs;               // adjustments that would have run g_ms backwards.  taken from the next delta
+static bool         g_madjLocked;           // the last frequency correction was small
+static uint32       g_lockedAt;             // g_poweredOnTime when first locked after boot (0 if not yet)
 
 uint32              g_poweredOnTime;        // elasped seconds since poweron (non-adjusted)
 uint32              g_ms;                   // current ms (adjusted)
 time_t              g_gmtTime;              // current gmt time
 time_t              g_now;                  // local time
 
-static uint64       g_madjPowerOnToNtp;     // offset from PoweredOnTimeAsMs() to ntp time as ms
-static uint64       g_madjSyncStart;        // when drift period has started
+static uint64       g_madjSyncStart;        // PoweredOnTimeAsMs() of the last ntp sample (0 if none)
+
+#define PPB                     1000000000LL        // parts per billion
+#define MADJ_MAX_PPB            500000              // +/- 500ppm.  well past any crystal
+#define SLEW_WINDOW_MS          ( 5 * 60 * 1000 )   // aim to finish a slew in this long
+#define SLEW_MIN_EVERY          20                  // but never faster than 5% (1ms per 20ms)
+#define SLEW_MAX_EVERY          2000                // or slower than 0.5ms per second
+#define MADJ_FLL_TAU_MS         ( 30 * 60 * 1000 )  // gain = interval / (interval + tau)
+#define MADJ_LOCK_PPB           5000                // corrections smaller than 5ppm count as locked
+#define DISCIPLINE_SAVE_PPB     500                 // save the record if the frequency moves by 0.5ppm
+#define DISCIPLINE_SAVE_SECONDS ( 6 * 60 * 60 )     // but not more often than this (unless the lock changed)
+
+
+// persisted clock discipline state
+struct Discipline
+{
+    uint32              _checksum;
+    int32               _ppb;                   // frequency estimate
+    uint8               _confidence;            // # of consecutive locked syncs (saturates)
+    uint8               _next;                  // next slot in _errorPpb
+    int16               _lastDriftMs;           // quality of the last sync.  its drift ...
+    uint32              _lastIntervalS;         // ... over this long
+    int32               _errorPpb[ 4 ];         // the last few measured frequency errors
+
+    uint32              Checksum() const;
+};
+
+static_assert( sizeof(Discipline) <= SettingsStore::k_maxValue, "Discipline record too large" );
+
+static Discipline   g_discipline;           // as it is now
+static int32        g_savedPpb;             // g_discipline._ppb as last written
+static bool         g_savedLocked;          // g_discipline._confidence != 0 as last written
+static uint32       g_savedAt;              // g_poweredOnTime as last written
 
 
 uint64
@@ -45,7 +95,7 @@ GmtTimeAsMs()
 String
 LastMicroAdjust()
 {
-    if ( g_madjPowerOnToNtp )
+    if ( g_madjSyncStart )
     {
         const uint64    poweredOnTimeMs = PoweredOnTimeAsMs();
         const uint64    sinceStart = (poweredOnTimeMs - g_madjSyncStart);
@@ -60,19 +110,120 @@ LastMicroAdjust()
 
 
 String
-MadjSecondsPerDay( int32 rate )
+MadjSecondsPerDay( int32 ppb )
+{
+    const int32     msPerDay = int32( (int64(ppb) * (24 * 60 * 60 * 1000)) / PPB );
+    String          str;
+
+    AppendF( str, "%s%d.%03d", (msPerDay < 0) ? "-" : "", ABS(msPerDay) / 1000, ABS(msPerDay) % 1000 );
+    return str;
+}
+
+
+bool
+MadjIsLocked()
+{
+    return g_madjLocked;
+}
+
+
+String
+TimeToLock()
 {
-    if ( rate )
+    return g_lockedAt ? Duration( g_lockedAt ) : String( "not locked" );
+}
+
+
+String
+DisciplineStr()
+{
+    String      str;
+
+    AppendF( str, "confidence %d, last drift %dms over %s, errors", g_discipline._confidence, g_discipline._lastDriftMs, Duration( g_discipline._lastIntervalS ).c_str() );
+    for ( uint index = 0; index < countof(g_discipline._errorPpb); ++index )
     {
-        float   msPerDay = float( 24 * 60 * 60 * 1000 ) / float( rate );
-        float   secondsPerDay = msPerDay / 1000.0;
+        AppendF( str, " %d", g_discipline._errorPpb[ (g_discipline._next + index) % countof(g_discipline._errorPpb) ] );
+    }
+    AppendF( str, "ppb" );
+    return str;
+}
 
-        return String( secondsPerDay, 3 );
+
+uint32
+Discipline::Checksum() const
+{
+    uint8 const   * const start     = (uint8 const *) this;
+    uint32                  checksum = sizeof( *this );
+
+    for ( uint pos = sizeof(_checksum); pos < sizeof(*this); ++pos )
+    {
+        checksum = (checksum << 1) + (start[ pos ] ^ 0x5A);
     }
-    else
+
+    return checksum;
+}
+
+
+// called after the Options are loaded
+void
+LoadDiscipline()
+{
+    if ( (!g_settings.Read( SettingsStore::k_keyDiscipline, &g_discipline, sizeof(g_discipline) )) ||
+         (g_discipline._checksum != g_discipline.Checksum()) || (ABS(g_discipline._ppb) > MADJ_MAX_PPB) )
     {
-        return "0";
+        Out( "Adj: no discipline record\n" );
+        memset( &g_discipline, 0, sizeof(g_discipline) );
     }
+    else if ( g_options._madjEnable )
+    {
+        // start where we left off.  the first interval after the boot's time step confirms the lock
+        g_options._madjPpb = g_discipline._ppb;
+        g_madjLocked = ( g_discipline._confidence != 0 );
+        Out( "Adj: restored %dppb, confidence %d\n", g_discipline._ppb, g_discipline._confidence );
+    }
+
+    g_savedPpb = g_discipline._ppb;
+    g_savedLocked = ( g_discipline._confidence != 0 );
+}
+
+
+static void
+SaveDiscipline()
+{
+    const bool      locked      = ( g_discipline._confidence != 0 );
+    const int32     movedPpb    = ( g_discipline._ppb - g_savedPpb );
+    const bool      moved       = ( ABS(movedPpb) >= DISCIPLINE_SAVE_PPB );
+    const bool      stale       = ( (!g_savedAt) || (g_poweredOnTime - g_savedAt >= DISCIPLINE_SAVE_SECONDS) );
+
+    if ( (locked != g_savedLocked) || ((moved) && (stale)) )
+    {
+        Out( "Adj: save discipline\n" );
+        g_discipline._checksum = g_discipline.Checksum();
+        g_settings.Append( SettingsStore::k_keyDiscipline, &g_discipline, sizeof(g_discipline) );
+
+        g_savedPpb = g_discipline._ppb;
+        g_savedLocked = locked;
+        g_savedAt = g_poweredOnTime;
+    }
+}
+
+
+uint32
+MsToNextSecond()
+{
+    return ( 1000 - g_lastPosGmtMs );
+}
+
+
+// millis() is micros64() / 1000, so the us since g_lastMs ticked are the whole ms since plus
+// the fraction of the current ms
+uint32
+GmtUsIntoSecond()
+{
+    const uint64    nowUs   = micros64();
+    const uint32    sinceUs = ( uint32(nowUs / 1000) - g_lastMs ) * 1000 + uint32( nowUs % 1000 );
+
+    return ( (g_lastPosGmtMs * 1000) + sinceUs ) % 1000000;
 }
 
 
@@ -96,16 +247,38 @@ UpdateTime()
             g_lastPosPowerMs -= 1000;
         }
     
-        // adjust deltaMs.  should only loop 0 or 1 time.  so deltaMs should not go negative
-        if ( g_options._madjFreq )
+        // adjust deltaMs by the frequency correction & any phase slew
+        const int32     elapsedMs = deltaMs;
+
+        if ( g_options._madjPpb )
+        {
+            int32   adjMs;
+
+            g_madjAccum += int64(elapsedMs) * g_options._madjPpb;
+            adjMs = int32( g_madjAccum / PPB );
+            g_madjAccum -= int64(adjMs) * PPB;
+            deltaMs += adjMs;
+        }
+
+        if ( g_slewMs )
         {
-            g_lastPosMadj += deltaMs;
-            while ( g_lastPosMadj >= g_options._madjFreq )
+            g_slewPos += elapsedMs;
+            while ( (g_slewPos >= g_slewEvery) && (g_slewMs) )
             {
-                deltaMs += g_options._madjDir;
-                g_lastPosMadj -= g_options._madjFreq;
+                const int32     dir = ( g_slewMs < 0 ) ? -1 : 1;
+
+                g_slewPos -= g_slewEvery;
+                g_slewMs -= dir;
+                g_slewTotal += dir;
+                deltaMs += dir;
             }
         }
+
+        // a -1 from each can land on the same 1ms delta.  the time doesn't go backwards, it
+        // holds still and the rest comes off the next delta
+        deltaMs += g_owedMs;
+        g_owedMs = MIN( deltaMs, 0 );
+        deltaMs -= g_owedMs;
     
         // ms
         g_ms += deltaMs;
@@ -125,55 +298,57 @@ UpdateTime()
 
 
 void
-MicroAdjust( uint64 ntpTimeMs )
+MicroAdjust( int64 offsetMs )
 {
     const uint64    poweredOnTimeMs = PoweredOnTimeAsMs();
 
-    // sync time is close
-    if ( g_madjPowerOnToNtp )
+    // frequency.  the offset not explained by a slew still in progress built up over the interval
+    if ( g_madjSyncStart )
     {
-        const uint64    ourNtpTimeMs    = poweredOnTimeMs + g_madjPowerOnToNtp;
-        const int64     ntpDiffMs       = ourNtpTimeMs - ntpTimeMs;
-        const uint64    sinceStart      = ( poweredOnTimeMs - g_madjSyncStart );
+        const int64     intervalMs  = ( poweredOnTimeMs - g_madjSyncStart );
+        const int64     pendingMs   = g_slewMs;
+        const int64     driftMs     = ( offsetMs - pendingMs );
 
-      //Log( "Adj: %s, %s, %d\n", u64str(ntpTimeMs).c_str(), u64str(ourNtpTimeMs).c_str(), u64str(ntpDiffMs).c_str() );
-        Log( "Adj: sync %s, Drift %d\n", u64str(sinceStart).c_str(), int32(ntpDiffMs) );
-        if ( ABS(ntpDiffMs) < 1000 )
+        // more than 1% is not drift (a bad sample or the time was changed)
+        if ( (intervalMs <= 0) || (ABS(driftMs) > intervalMs / 100) )
         {
-            Log( "Adj: Not enough drift\n" );
-            return;
+            Log( "Adj: sync %s, drift %s ignored\n", u64str(intervalMs).c_str(), u64str(driftMs).c_str() );
         }
-
-        if ( sinceStart < (9 * 60 * 60 * 1000) )
+        else
         {
-            Log( "Adj: Not enough time\n" );
-            return;
-        }
-
-        const float     msDriftPerMs    = float( -ntpDiffMs ) / float( sinceStart );
-        const float     msDriftPerDay   = msDriftPerMs * float( 24 * 60 * 60 * 1000 );
-        const int32     msDesiredRate   = float( 24 * 60 * 60 * 1000 ) / msDriftPerDay;
-        const int32     oldRate         = ( g_options._madjFreq * g_options._madjDir );
-
-        g_options._madjSmooth.Push( msDesiredRate );
+            const int32     errorPpb    = int32( constrain( (driftMs * PPB) / intervalMs, -int64(MADJ_MAX_PPB), int64(MADJ_MAX_PPB) ) );
+            const int32     stepPpb     = int32( (int64(errorPpb) * intervalMs) / (intervalMs + MADJ_FLL_TAU_MS) );
+            const int32     oldPpb      = g_options._madjPpb;
 
-        const int       msNewRate       = g_options._madjSmooth.Value();
+            Log( "Adj: sync %s, drift %d, error %dppb\n", u64str(intervalMs).c_str(), int32(driftMs), errorPpb );
 
-      //Log( "Adj: Old Rate %d, New Rate %d\n", oldRate, msNewRate );
-        Log( "Adj: Old Rate %s, New Rate %s\n", MadjSecondsPerDay(oldRate).c_str(), MadjSecondsPerDay(msNewRate).c_str() );
+            g_madjLocked = ( ABS(stepPpb) < MADJ_LOCK_PPB );
+            if ( (g_madjLocked) && (!g_lockedAt) )
+            {
+                g_lockedAt = MAX( g_poweredOnTime, uint32(1) );
+                Log( "Adj: locked after %s\n", TimeToLock().c_str() );
+            }
 
-        if ( g_options._madjEnable )
-        {
-            if ( msNewRate != oldRate )
+            if ( g_options._madjEnable )
             {
-                g_options._madjDir = ( msNewRate < 0 ? -1 : 1 );
-                g_options._madjFreq = ABS( msNewRate );
-                g_options._dirty = true;
+                g_options._madjPpb = constrain( oldPpb + stepPpb, -MADJ_MAX_PPB, MADJ_MAX_PPB );
+                if ( g_options._madjPpb != oldPpb )
+                {
+                    Log( "Adj: Old Rate %s, New Rate %s\n", MadjSecondsPerDay(oldPpb).c_str(), MadjSecondsPerDay(g_options._madjPpb).c_str() );
+                }
+
+                g_discipline._ppb = g_options._madjPpb;
+                g_discipline._confidence = g_madjLocked ? MIN( g_discipline._confidence + 1, 255 ) : 0;
+                g_discipline._lastDriftMs = int16( constrain( driftMs, int64(INT16_MIN), int64(INT16_MAX) ) );
+                g_discipline._lastIntervalS = uint32( intervalMs / 1000 );
+                g_discipline._errorPpb[ g_discipline._next ] = errorPpb;
+                g_discipline._next = ( g_discipline._next + 1 ) % countof( g_discipline._errorPpb );
+                SaveDiscipline();
+            }
+            else
+            {
+                Log( "Adj: disabled\n" );
             }
-        }
-        else
-        {
-            Log( "Adj: disabled\n" );
         }
     }
     else
@@ -182,11 +357,48 @@ MicroAdjust( uint64 ntpTimeMs )
     }
 
     // reset for next drift
-    g_madjPowerOnToNtp = ( ntpTimeMs - poweredOnTimeMs );
     g_madjSyncStart = poweredOnTimeMs;
 }
 
 
+void
+SlewPhase( int32 offsetMs )
+{
+    const uint32    absMs = ABS( offsetMs );
+
+    g_slewEvery = absMs ? constrain( SLEW_WINDOW_MS / absMs, uint32(SLEW_MIN_EVERY), uint32(SLEW_MAX_EVERY) ) : SLEW_MAX_EVERY;
+    g_slewMs    = offsetMs;
+    g_slewPos   = 0;
+}
+
+
+int32
+SlewTotal()
+{
+    return g_slewTotal;
+}
+
+
+String
+SlewStr()
+{
+    String      str;
+
+    if ( g_slewMs )
+    {
+        const uint32    secondsLeft = ( uint32(ABS(g_slewMs)) * g_slewEvery - g_slewPos ) / 1000;
+
+        AppendF( str, "%dms over %ds", g_slewMs, secondsLeft );
+    }
+    else
+    {
+        str = "none";
+    }
+
+    return str;
+}
+
+
 // Replacement for TimeLib::setTime()
 bool
 SetNtpTime( time_t ntpTime, uint32 ntpMs )
@@ -198,8 +410,8 @@ SetNtpTime( time_t ntpTime, uint32 ntpMs )
     const int64     diffMs      = ( ntpTimeMs - gmtMs );
     bool            resync      = false;
 
-    // skip if time diff is less then 1/4 second
-    if ( ABS(diffMs) > 250 ) 
+    // step if the diff is too large to slew
+    if ( ABS(diffMs) > g_options._slewMaxMs ) 
     {
         // udpate gtmTime
         g_gmtTime       = ntpTime;
@@ -207,6 +419,8 @@ SetNtpTime( time_t ntpTime, uint32 ntpMs )
         g_now           = g_gmtTime + g_options._gmtOffset;
 
         Log( "Time: %s, adjust %ss\n", TimeStr().c_str(), String( (float(diffMs) / 1000.0), 3).c_str() );
+        MicroAdjust( diffMs );
+        g_slewMs = 0;
         UpdateWaitTimes();
 
         // do quick resyncs until we get close
@@ -214,9 +428,12 @@ SetNtpTime( time_t ntpTime, uint32 ntpMs )
     }
     else
     {
-        // diff is small.. check for micro adjustment
+        // diff is small.. slew it out and update the frequency correction.  resync
+        // quickly until the frequency settles (or if it was more than 1/4 second off)
         Log( "Time: %s (%d)\n", TimeStr().c_str(), int32( diffMs ) );
-        MicroAdjust( ntpTimeMs );
+        MicroAdjust( diffMs );
+        SlewPhase( int32(diffMs) );
+        resync = ( !g_madjLocked ) || ( ABS(diffMs) > 250 );
     }
 
     return resync;
@@ -10,7 +10,16 @@
 void    UpdateTime();                           // called at the start of loop()
 bool    SetNtpTime( time_t time, uint32 ms );   // replacement for TimeLib::SetTime()
 String  LastMicroAdjust();
-String  MadjSecondsPerDay( int32 rate );
+String  MadjSecondsPerDay( int32 ppb );
+bool    MadjIsLocked();                         // the last ntp sync only needed a small frequency correction
+String  SlewStr();                              // the phase slew in progress (if any)
+int32   SlewTotal();                            // ms slewed in since boot.  (a running total)
+String  TimeToLock();                           // how long after boot the clock discipline locked
+String  DisciplineStr();                        // the persisted discipline state
+void    LoadDiscipline();                       // restore the discipline state (after the Options are loaded)
+uint64  GmtTimeAsMs();                          // g_gmtTime in ms (as of the last UpdateTime())
+uint32  MsToNextSecond();                       // ms (as of the last UpdateTime()) until g_gmtTime changes
+uint32  GmtUsIntoSecond();                      // us since g_gmtTime last changed.  as of now
 
 // read-only globals (updated when UpdateTime() is called)
 extern time_t       g_gmtTime;              // in seconds
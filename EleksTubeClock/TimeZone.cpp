@@ -1,6 +1,7 @@
 /*
  * TimeZone
- *  Note timezone updates are synchronous (the clock will stop when updating)
+ *  Timezone updates are two http requests run as a state machine.  Each call to Loop()
+ *  advances the current request one step, so the clock keeps running while syncing.
  *  Thanks to https://github.com/ib134866/EleksTube for the basic usage & idea*
  *
  * Author: Ken Reneris <https://github.com/KenReneris>
@@ -9,16 +10,17 @@
 
 
 #include "platform.h"
-#include <ArduinoJson.h>                // json library for parsing http results - https://arduinojson.org/?utm_source=meta&utm_medium=library.properties
-#include <ESP8266HTTPClient.h>     
 #include "TimeZone.h"
+#include "FlightRecorder.h"
+
+#define REQUEST_TIMEOUT_MS      10000           // abandon a request after 10 seconds
+#define MAX_READ_PER_STEP       128             // bytes read per step
 
 
 void
 TimeZone::Setup()
 {
     _state = ( g_options._tzKey[0] ? WaitingForWifi : Disabled );
-    _isValid = false;
     _isDst = false;
     _dstStart = 0;
     _dstEnd = 0;
@@ -45,7 +47,14 @@ TimeZone::GetState() const
 char const *
 TimeZone::GetStateStr() const
 {
-    switch ( _state )
+    return StateStr( _state );
+}
+
+
+char const *
+TimeZone::StateStr( State state )
+{
+    switch ( state )
     {
     case Disabled:            return "Disabled";
     case WaitingForWifi:      return "WaitingForWifi";
@@ -65,23 +74,26 @@ TimeZone::Loop()
     {
 
     case Disabled:
+        break;
+
     case SyncingTimeZone:
-    case WaitingForRetry:
+        SyncStep();
         break;
 
     case WaitingForWifi:
         if ( g_wifiIsConnected )
         {
-            UpdateTimeZone();
+            SetState( SyncingTimeZone );
         }
         break;
 
     case WaitingForSyncTime:
+    case WaitingForRetry:
         if ( g_poweredOnTime >= _nextTime )
         {
             if ( g_wifiIsConnected )
             {
-                UpdateTimeZone();
+                SetState( SyncingTimeZone );
             }
             else
             {
@@ -106,6 +118,8 @@ TimeZone::SetState( State state )
 
         case SyncingTimeZone:
             g_globalColor.ClearState( GlobalColor::SyncingTimeZone );
+            _client.stop();
+            _path = String();
             break;
 
         case WaitingForRetry:
@@ -115,6 +129,7 @@ TimeZone::SetState( State state )
         // new state
         _state = state;
         Out( "TimeZone: %s\n", GetStateStr() );
+        g_flightRecorder.State( FlightRecorder::Kind::TimeZoneState, state );
         switch ( state )
         {
         case WaitingForSyncTime:
@@ -123,6 +138,7 @@ TimeZone::SetState( State state )
 
         case SyncingTimeZone:
             g_globalColor.EnableState( GlobalColor::SyncingTimeZone );
+            StartRequest( GeoLocation, "ip-api.com", "/json/?fields=timezone" );
             break;
 
         case WaitingForRetry:
@@ -134,90 +150,209 @@ TimeZone::SetState( State state )
 }
 
 
-JsonVariant
-GetJsonField( TimeZone *client, const JsonObject &root, char const *name )
+void
+TimeZone::StartRequest( Request request, char const *host, String const &path )
 {
-    if ( !root.containsKey(name) )
+    Out( "TimeZone: Request %s\n", host );
+    _request    = request;
+    _host       = host;
+    _path       = path;
+    _step       = Step::Resolve;
+    _deadline   = g_ms + REQUEST_TIMEOUT_MS;
+    _httpStatus = 0;
+    _spaces     = 0;
+    _lineLength = 0;
+
+    // the values buffer is split between the fields of this request
     {
-        client->JsonParseFailure( name );
+        uint8       count   = 0;
+        char      * value   = _values;
+
+        auto addField =
+            [&]( char const *name, uint8 size )
+            {
+                _fields[ count ] = { name, value, size };
+                value += size;
+                count += 1;
+            };
+
+        if ( request == GeoLocation )
+        {
+            addField( "timezone", sizeof(_values) );
+        }
+        else
+        {
+            addField( "gmtOffset", 12 );
+            addField( "dst", 12 );
+            addField( "zoneStart", 12 );
+            addField( "zoneEnd", 12 );
+        }
+
+        _json.Reset( _fields, count );
     }
+}
 
-    return root[ name ];
+
+void
+TimeZone::SyncFailure( char const *reason )
+{
+    Out( "TimeZone: %s failed (%s)\n", _host, reason );
+    SetState( WaitingForRetry );
 }
 
 
-JsonObject 
-GetJsonResponse( TimeZone *client, String url, DynamicJsonDocument &jsonDoc )
+// one step of the current request.  called from Loop()
+void
+TimeZone::SyncStep()
 {
-    HTTPClient              http;
-    String                  str;
+    if ( int32(g_ms - _deadline) > 0 )
+    {
+        SyncFailure( "timeout" );
+        return;
+    }
+
+    switch ( _step )
+    {
+    case Step::Resolve:
+        if ( WiFi.hostByName( _host, _ip ) )
+        {
+            _step = Step::Connect;
+        }
+        else
+        {
+            SyncFailure( "dns" );
+        }
+        break;
+
+    case Step::Connect:
+        if ( _client.connect( _ip, 80 ) )
+        {
+            _step = Step::Send;
+        }
+        else
+        {
+            SyncFailure( "connect" );
+        }
+        break;
 
-    http.begin( url );
-    http.GET();
-    str = http.getString();
-    http.end();
+    case Step::Send:
+        {
+            // http/1.0 so the body is never chunked and ends when the server closes
+            const String    request = PrintF( "GET %s HTTP/1.0\r\nHost: %s\r\nConnection: close\r\n\r\n", _path.c_str(), _host );
+
+            _client.write( (uint8 const *) request.c_str(), request.length() );
+            _step = Step::Status;
+        }
+        break;
+
+    case Step::Status:
+    case Step::Headers:
+    case Step::Body:
+        ReadResponse();
+        break;
 
-    deserializeJson( jsonDoc, str );
-    return jsonDoc.as<JsonObject>();
+    case Step::Parse:
+        ParseResponse();
+        break;
+    }
 }
 
 
 void
-TimeZone::UpdateTimeZone()
+TimeZone::ReadResponse()
 {
-    String                  url;
-    int32                   gmtOffset;
-
-    SetState( SyncingTimeZone );
-    Out( "TimeZone: Update\n" );
-    _isValid = true;
+    int     count   = MIN( _client.available(), MAX_READ_PER_STEP );
 
+    for ( ; count > 0; --count )
     {
-        DynamicJsonDocument     jsonDoc;
-        JsonObject              root        = GetJsonResponse( this, "http://ip-api.com/json/?fields=timezone", jsonDoc );
-        String                  timeZone    = GetJsonField( this, root, "timezone" );
+        const char  c   = _client.read();
 
-        url = PrintF( "http://api.timezonedb.com/v2.1/get-time-zone?key=%s&format=json&by=zone&zone=%s", g_options._tzKey, timeZone.c_str() );
-    }
+        switch ( _step )
+        {
+        case Step::Status:
+            if ( c == '\n' )
+            {
+                _step = Step::Headers;
+            }
+            else if ( c == ' ' )
+            {
+                _spaces += 1;
+            }
+            else if ( (_spaces == 1) && (c >= '0') && (c <= '9') )
+            {
+                _httpStatus = _httpStatus * 10 + ( c - '0' );
+            }
+            break;
 
-    {
-        DynamicJsonDocument     jsonDoc;
-        JsonObject              root = GetJsonResponse( this, url, jsonDoc );
+        case Step::Headers:
+            if ( c == '\n' )
+            {
+                if ( !_lineLength )
+                {
+                    _step = Step::Body;
+                }
+                _lineLength = 0;
+            }
+            else if ( (c != '\r') && (_lineLength < 255) )
+            {
+                _lineLength += 1;
+            }
+            break;
 
-        gmtOffset       = GetJsonField( this, root, "gmtOffset" );
-        _isDst          = GetJsonField( this, root, "dst" );
-        _dstStart       = GetJsonField( this, root, "zoneStart" );
-        _dstEnd         = GetJsonField( this, root, "zoneEnd" );
+        case Step::Body:
+            _json.Push( c );
+            break;
+        }
     }
 
-    if ( _isValid )
+    if ( (!_client.available()) && (!_client.connected()) )
     {
-        if ( gmtOffset != g_options._gmtOffset )
+        _client.stop();
+        if ( (_step != Step::Body) || (_httpStatus != 200) )
         {
-            Out( "TimeZone: gmtOffset %d\n", gmtOffset );
-            g_options._gmtOffset = gmtOffset;
-            g_options.Save();
+            SyncFailure( "response" );
         }
         else
         {
-            Out( "TimeZone: checked.  no change\n" );
+            _step = Step::Parse;
         }
-        SetState( WaitingForSyncTime );
-    }
-    else
-    {
-        SetState( WaitingForRetry );
     }
 }
 
 
 void
-TimeZone::JsonParseFailure( char const * fieldName )
+TimeZone::ParseResponse()
 {
-    if ( _isValid )
+    JsonScan::Field const     * missing     = _json.Missing();
+
+    if ( missing )
+    {
+        Out( "TimeZone: update failure on field '%s'\n", missing->_name );
+        SetState( WaitingForRetry );
+    }
+    else if ( _request == GeoLocation )
+    {
+        StartRequest( ZoneInfo, "api.timezonedb.com", PrintF( "/v2.1/get-time-zone?key=%s&format=json&by=zone&zone=%s", g_options._tzKey, _fields[ 0 ]._value ) );
+    }
+    else
     {
-        Out( "TimeZone: update failure on field '%s'\n", fieldName );
-        _isValid = false;
+        const int32     gmtOffset   = atoi( _fields[ 0 ]._value );
+
+        _isDst          = ( atoi( _fields[ 1 ]._value ) != 0 );
+        _dstStart       = atoi( _fields[ 2 ]._value );
+        _dstEnd         = atoi( _fields[ 3 ]._value );
+
+        if ( gmtOffset != g_options._gmtOffset )
+        {
+            Out( "TimeZone: gmtOffset %d\n", gmtOffset );
+            g_options._gmtOffset = gmtOffset;
+            g_options.SaveSoon();
+        }
+        else
+        {
+            Out( "TimeZone: checked.  no change\n" );
+        }
+        SetState( WaitingForSyncTime );
     }
 }
 
@@ -1,6 +1,7 @@
 /*
  * TimeZone.h
  *   If automatic timezone (and DST) beign used, this class performs the IOs and makes the timezone updates.
+ *   The http requests are advanced a step at a time from Loop() so the display keeps running.
  *
  * Author: Ken Reneris <https://github.com/KenReneris>
  * MIT License
@@ -29,18 +30,55 @@ public:
     State           GetState() const;
     char const    * GetStateStr() const;
 
-    // used by GetJsonField
-    void            JsonParseFailure( char const * fieldName );
+    static char const * StateStr( State state );
+
+private:
+    // steps of one http request
+    enum class Step : uint8
+    {
+        Resolve,                // dns lookup of the host
+        Connect,                // tcp connect
+        Send,                   // send the GET
+        Status,                 // reading "HTTP/1.0 200 OK"
+        Headers,                // skipping the response headers
+        Body,                   // reading the json body until the server closes
+        Parse,                  // act on the fields pulled from the body
+    };
+
+    // requests made for each sync
+    enum Request : uint8
+    {
+        GeoLocation,            // ip-api.com for our timezone name
+        ZoneInfo,               // api.timezonedb.com for the offset & dst times of that timezone
+    };
 
 private:
     void            SetState( State state );
-    void            UpdateTimeZone();
+    void            StartRequest( Request request, char const *host, String const &path );
+    void            SyncStep();
+    void            ReadResponse();
+    void            ParseResponse();
+    void            SyncFailure( char const *reason );
 
 private:
     State           _state;
     uint32          _nextTime;      // next time to fetch a timezone update
 
-    bool            _isValid;
+    // current request
+    Request         _request;
+    Step            _step;
+    char const    * _host;
+    String          _path;
+    IPAddress       _ip;
+    WiFiClient      _client;
+    uint32          _deadline;      // g_ms when the request is abandoned
+    uint16          _httpStatus;
+    uint8           _spaces;        // spaces seen on the status line
+    uint8           _lineLength;    // length of the current header line
+    JsonScan        _json;          // pulls _fields out of the body as it arrives
+    JsonScan::Field _fields[ 4 ];
+    char            _values[ 48 ];  // text of the _fields values
+
     bool            _isDst;
     int32           _dstStart;
     int32           _dstEnd;
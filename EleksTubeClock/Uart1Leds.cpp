@@ -0,0 +1,97 @@
+/*
+ * Uart1Leds
+ *  WS2812 over UART1.
+ *
+ *  A WS2812 bit is 1.25us: high then low, with a 0 high for 1/4 of it and a 1 high for
+ *  3/4.  At 3.2 Mbaud a UART bit is 1/4 of a led bit, and a 6N1 character (start, 6
+ *  data, stop) is 8 UART bits, so each character carries 2 led bits.  With TX
+ *  inverted the line idles low (the led latch level), the start bit is the leading
+ *  high, the stop bit is the trailing low, and the data bits shape the middle.
+ *  Each led byte is 4 characters.
+ *
+ *  The characters are written straight into the 128 byte TX FIFO (320us of output).
+ *  Filling it from a TX empty interrupt would leave nothing to wait on, but UART0 and
+ *  UART1 share one interrupt and Serial's RX (the console) owns it.
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+#include "platform.h"
+#include "Uart1Leds.h"
+
+#if LED_UART1
+
+#define UART1_TX_PIN        2                   // GPIO2 (D4).  UART1 has no other TX pin
+#define UART_BAUD           3200000             // 4 UART bits per led bit (800KHz)
+#define UART_FIFO_SIZE      128
+#define UART_TX_COUNT       ( (USS(1) >> USTXC) & 0xFF )
+#define UART_CHAR_NS        2500                // 8 bits at UART_BAUD
+#define LATCH_US            300                 // line held low this long latches the frame.  (older parts only need 50)
+
+
+// the character for each pair of led bits.  (the first bit sent is the high bit of the pair)
+static const uint8      k_encode[ 4 ] = { 0b110111, 0b000111, 0b110100, 0b000100 };
+
+Uart1Leds               g_uart1Leds;
+
+
+Uart1Leds::Uart1Leds()
+    : _doneUs       ( 0 )
+{
+}
+
+
+void
+Uart1Leds::init()
+{
+    pinMode( UART1_TX_PIN, SPECIAL );
+
+    USD( 1 ) = ESP8266_CLOCK / UART_BAUD;
+    USC0( 1 ) = (1 << UCBN) | (1 << UCSBN) | (1 << UCTXI);    // 6 data bits, 1 stop bit, TX inverted
+    USC1( 1 ) = 0;
+    USIE( 1 ) = 0;
+
+    // empty the fifo
+    USC0( 1 ) |= (1 << UCTXRST);
+    USC0( 1 ) &= ~(1 << UCTXRST);
+}
+
+
+void
+Uart1Leds::Put( uint8 value )
+{
+    while ( UART_TX_COUNT > UART_FIFO_SIZE - 4 )
+    {
+    }
+
+    USF( 1 ) = k_encode[ (value >> 6) & 3 ];
+    USF( 1 ) = k_encode[ (value >> 4) & 3 ];
+    USF( 1 ) = k_encode[ (value >> 2) & 3 ];
+    USF( 1 ) = k_encode[ value & 3 ];
+}
+
+
+void
+Uart1Leds::showPixels( PixelController<GRB> &pixels )
+{
+    // the last frame has to have gone out and latched.  (at the frame rate it long has)
+    while ( int32( micros() - _doneUs ) < LATCH_US )
+    {
+    }
+
+    while ( pixels.has( 1 ) )
+    {
+        Put( pixels.loadAndScale0() );
+        Put( pixels.loadAndScale1() );
+        Put( pixels.loadAndScale2() );
+        pixels.advanceData();
+        pixels.stepDithering();
+    }
+
+    // don't wait for the fifo to drain.  note when it will have
+    _doneUs = micros() + ( (UART_TX_COUNT * UART_CHAR_NS) / 1000 );
+}
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * Uart1Leds.h
+ *  FastLED controller that sends the WS2812 bit stream out UART1's TX pin (GPIO2, D4)
+ *  instead of bit-banging it.  The UART shapes the pulses, so the show runs with
+ *  interrupts enabled.  An interrupt only has to finish before the TX FIFO drains.
+ *
+ *  Selected with LED_UART1 (platform.h).  The led data line moves to GPIO2, and it
+ *  drives one strip.  (NEOLED_PIN2 isn't supported)
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+class Uart1Leds : public CPixelLEDController<GRB>
+{
+public:
+    Uart1Leds();
+
+    void                init() override;
+
+protected:
+    void                showPixels( PixelController<GRB> &pixels ) override;
+
+private:
+    static void         Put( uint8 value );
+
+private:
+    uint32              _doneUs;                    // micros() when the last frame's final bit goes out
+};
+
+
+extern Uart1Leds        g_uart1Leds;
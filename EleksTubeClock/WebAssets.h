@@ -0,0 +1,239 @@
+/*
+ * WebAssets.h
+ *  Generated by web/gzip_assets.py.  Do not edit.
+ *
+ * Author: Ken Reneris <https://github.com/KenReneris>
+ * MIT License
+ * ----------------------------------------------------------
+ */
+
+
+// cp.min.js: 5940 bytes, 2698 gzip'd
+static const char     k_CpJsType[]     = "application/javascript";
+static const char     k_CpJsEtag[]     = "\"d11d3ed731e766be\"";
+static const uint8    k_CpJsGz[] PROGMEM =
+{
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x58, 0x6d, 0x57, 0xdb, 0xb8,
+    0x12, 0xfe, 0x2b, 0xe0, 0x65, 0x59, 0x89, 0x28, 0xce, 0x4b, 0x5b, 0xce, 0xbd, 0x09, 0x22, 0xa7,
+    0x2f, 0xb4, 0xb4, 0x85, 0xd2, 0xdd, 0x66, 0xbb, 0x74, 0xd3, 0x5c, 0x8e, 0x71, 0x94, 0xd8, 0x60,
+    0xe4, 0xd4, 0x56, 0x02, 0x94, 0xe4, 0xbf, 0xdf, 0x67, 0x64, 0x3b, 0x76, 0x20, 0x7b, 0x3f, 0x5c,
+    0xce, 0xc1, 0x1a, 0x69, 0x46, 0xa3, 0xd1, 0x68, 0xe6, 0xd1, 0x28, 0xdb, 0xe3, 0x99, 0xf6, 0x4d,
+    0x18, 0x6b, 0x66, 0x84, 0x16, 0x8a, 0x3f, 0x14, 0xfd, 0xad, 0x84, 0x19, 0xfe, 0x90, 0x28, 0x33,
+    0x4b, 0xf4, 0xd6, 0x3c, 0x0e, 0x47, 0x5b, 0xcd, 0x6d, 0x29, 0xcd, 0x72, 0xc5, 0x0f, 0x4b, 0xbe,
+    0x93, 0x9a, 0x24, 0xd4, 0x13, 0x07, 0xfc, 0xfb, 0xa9, 0x8a, 0xc7, 0x5b, 0x15, 0xb1, 0xb8, 0x22,
+    0x16, 0x5f, 0x5e, 0x29, 0xdf, 0x6c, 0x14, 0x9b, 0x55, 0x56, 0x3b, 0xb3, 0x62, 0xee, 0xb5, 0xba,
+    0x4f, 0x31, 0xea, 0x46, 0x4a, 0x4f, 0x4c, 0x50, 0x8a, 0xfa, 0x85, 0xa9, 0xb9, 0xb8, 0x3e, 0x34,
+    0x3d, 0xdd, 0x31, 0x87, 0xaa, 0xa7, 0x3a, 0x15, 0x8d, 0x29, 0x89, 0xad, 0x84, 0xa6, 0x5e, 0x92,
+    0xaa, 0xf7, 0xda, 0xd0, 0xe0, 0x62, 0xd1, 0x6a, 0xf2, 0x52, 0xd0, 0xab, 0x2c, 0x7d, 0xea, 0x99,
+    0xc0, 0x4d, 0xe2, 0x99, 0x1e, 0x61, 0xb0, 0x14, 0x19, 0x93, 0xc8, 0xdc, 0x4b, 0xb6, 0xb0, 0xae,
+    0x48, 0x44, 0x28, 0x62, 0x31, 0x13, 0xbe, 0x48, 0xc5, 0x58, 0xd6, 0xcc, 0xa0, 0x39, 0x14, 0x11,
+    0xb5, 0xad, 0xa1, 0x08, 0xa8, 0x6d, 0x0f, 0xbb, 0xe9, 0x6d, 0x68, 0xfc, 0x80, 0x85, 0xd2, 0x2a,
+    0x1c, 0x47, 0x71, 0x9c, 0xb0, 0xfd, 0xbd, 0x31, 0x17, 0xb1, 0x44, 0x53, 0x0f, 0xc5, 0x4c, 0x06,
+    0x7b, 0xac, 0x55, 0x8f, 0xb8, 0xf0, 0x33, 0x2a, 0xde, 0x03, 0x9d, 0x66, 0x34, 0x75, 0x39, 0xf5,
+    0x43, 0x19, 0x2e, 0x16, 0x4d, 0x88, 0xf8, 0xd4, 0xa4, 0x32, 0xa5, 0x26, 0xfc, 0x75, 0x9f, 0x3f,
+    0xf8, 0x5e, 0xaa, 0xb6, 0x9a, 0x1d, 0x2d, 0x03, 0xa1, 0x64, 0x2a, 0x12, 0x39, 0xeb, 0x5e, 0x26,
+    0xca, 0xbb, 0xee, 0x5a, 0x46, 0x0b, 0x0c, 0x1f, 0x8c, 0xe0, 0x31, 0xa3, 0x0d, 0xc6, 0x2c, 0x67,
+    0xa4, 0x55, 0xc6, 0xb3, 0x9c, 0xe1, 0x83, 0x11, 0x54, 0x19, 0xcf, 0xc1, 0x48, 0xc1, 0x98, 0x3d,
+    0x66, 0xbc, 0xc8, 0x17, 0x27, 0x86, 0xbf, 0xcc, 0xfc, 0x37, 0xf0, 0x58, 0xfb, 0xc5, 0x8b, 0x3d,
+    0xcd, 0x45, 0x46, 0xa8, 0x82, 0x48, 0xf8, 0xb0, 0xf4, 0x66, 0x54, 0x71, 0xf8, 0x94, 0x91, 0x6f,
+    0x2b, 0xae, 0x0e, 0x2a, 0xae, 0xce, 0x9d, 0x9b, 0xe4, 0xce, 0x0d, 0x33, 0xe7, 0xc2, 0x87, 0xd6,
+    0xab, 0x37, 0xde, 0x1d, 0xb3, 0xa7, 0xc1, 0xe1, 0xcd, 0x6c, 0x24, 0xd4, 0xc5, 0x88, 0x2f, 0xe3,
+    0xfa, 0x0c, 0x1e, 0x6b, 0x4a, 0x29, 0xe3, 0x5e, 0xb3, 0xe3, 0x37, 0x62, 0xe1, 0xc9, 0xb8, 0x01,
+    0x63, 0x8a, 0xc3, 0x89, 0x73, 0x2f, 0xce, 0xb0, 0x91, 0x66, 0x75, 0x67, 0x0a, 0x03, 0x49, 0x3d,
+    0xac, 0xf9, 0x7b, 0x2c, 0x3c, 0x4c, 0x7a, 0xfb, 0x9d, 0x26, 0x17, 0xba, 0x81, 0x83, 0xf3, 0xab,
+    0x52, 0x09, 0xa4, 0xc2, 0xba, 0xaa, 0xb5, 0xf7, 0xfc, 0x0d, 0xdc, 0x10, 0x5c, 0x55, 0x4f, 0x6a,
+    0xcf, 0x57, 0xdc, 0xc2, 0x45, 0x1a, 0x61, 0xe3, 0x55, 0xbc, 0x31, 0x5d, 0x6d, 0x38, 0xdb, 0xde,
+    0xc2, 0x6e, 0xf6, 0xe0, 0xe0, 0x5f, 0x0b, 0xbb, 0xfb, 0x83, 0x83, 0xd6, 0x7e, 0xb7, 0x88, 0x74,
+    0xe9, 0x34, 0xed, 0x9f, 0x53, 0xd3, 0xae, 0x89, 0xbf, 0xd8, 0xac, 0x63, 0xad, 0x7d, 0x98, 0xe7,
+    0xa6, 0x51, 0xe8, 0x2b, 0x56, 0xdf, 0xaf, 0xb8, 0x72, 0x5e, 0xf1, 0x73, 0xc0, 0x46, 0xeb, 0x7e,
+    0x1e, 0x55, 0x98, 0xcf, 0xe0, 0x24, 0x93, 0xe7, 0xd9, 0xee, 0x2e, 0x33, 0xe8, 0x24, 0x6a, 0x1a,
+    0x79, 0x50, 0xd8, 0x70, 0x1b, 0x13, 0xe1, 0xec, 0xec, 0xee, 0xec, 0x3a, 0x9c, 0x8b, 0x01, 0x92,
+    0x0a, 0x36, 0x65, 0xc7, 0x41, 0xeb, 0x52, 0xbf, 0x4d, 0xfd, 0x67, 0x65, 0xff, 0x39, 0xf5, 0x5f,
+    0xd8, 0x7e, 0x65, 0x9b, 0x93, 0x72, 0xbd, 0x81, 0xdd, 0x58, 0xe3, 0xd9, 0x7e, 0x53, 0x58, 0x4d,
+    0x8d, 0x56, 0xd3, 0x52, 0x6d, 0x4b, 0x55, 0xe6, 0xdc, 0x57, 0xe6, 0x78, 0x0c, 0xf2, 0x7b, 0x76,
+    0x26, 0x05, 0x15, 0x04, 0xf7, 0xec, 0xe4, 0x4a, 0xa7, 0x3d, 0xac, 0x2e, 0x78, 0xf7, 0x64, 0x41,
+    0x9c, 0x7d, 0xbe, 0x60, 0x4e, 0xb5, 0x2d, 0x55, 0x99, 0x73, 0x4c, 0x73, 0xc2, 0x31, 0x23, 0xd0,
+    0xe2, 0xb9, 0x73, 0x4c, 0x37, 0x3b, 0x9c, 0xc6, 0xf7, 0x74, 0x2f, 0x99, 0x5c, 0xe2, 0xfb, 0x9d,
+    0xe1, 0xc3, 0xbe, 0x8f, 0x6a, 0x1c, 0xad, 0xf8, 0x07, 0xfa, 0x3b, 0x7d, 0x76, 0x1a, 0xa1, 0xab,
+    0xee, 0x14, 0x10, 0x8b, 0x23, 0x9a, 0x49, 0x43, 0x90, 0xce, 0xff, 0x51, 0xc3, 0xaf, 0x8f, 0x3b,
+    0x4f, 0x74, 0x24, 0xd2, 0xf9, 0xc5, 0xa1, 0xc3, 0xc2, 0x76, 0x76, 0x77, 0x0d, 0x52, 0x80, 0x02,
+    0xb9, 0xf1, 0x9f, 0x5f, 0xd8, 0xe0, 0xfb, 0xc8, 0xab, 0x8f, 0x87, 0x0f, 0xcf, 0x96, 0x8b, 0x82,
+    0xdc, 0x5f, 0x72, 0xcc, 0xe5, 0x45, 0xf0, 0x24, 0x3d, 0xc4, 0x43, 0x1e, 0x26, 0x2d, 0xce, 0x3b,
+    0xaa, 0x37, 0x61, 0x83, 0x9a, 0xa2, 0x93, 0xc4, 0xb7, 0x6d, 0xbf, 0xcf, 0x86, 0x43, 0xde, 0xd1,
+    0xbd, 0x00, 0x0c, 0x6d, 0x19, 0xda, 0x32, 0x74, 0xc6, 0x18, 0x34, 0x45, 0x4b, 0xb4, 0x86, 0x4b,
+    0xf2, 0xc7, 0xa5, 0x74, 0x2e, 0x2e, 0x42, 0x9d, 0x1a, 0x4f, 0xfb, 0xea, 0xe2, 0xc2, 0x11, 0x37,
+    0xd2, 0x19, 0x87, 0x49, 0x6a, 0x5e, 0x07, 0x61, 0x34, 0x72, 0xc4, 0xb5, 0x4c, 0x95, 0xe9, 0x87,
+    0x37, 0x2a, 0x9e, 0x99, 0xee, 0x76, 0x79, 0xc9, 0xf0, 0x07, 0xe3, 0xce, 0x55, 0x92, 0xa2, 0x23,
+    0x9d, 0x96, 0xfb, 0xdc, 0x6d, 0x39, 0xc2, 0x0c, 0x2e, 0x87, 0xf2, 0x61, 0x29, 0x8c, 0xab, 0x3c,
+    0x3f, 0x90, 0x2b, 0xe1, 0x2a, 0xc8, 0x5f, 0xb3, 0xd5, 0x70, 0x96, 0x2d, 0xc8, 0x73, 0x49, 0x13,
+    0xbb, 0x63, 0x40, 0x2b, 0xf2, 0x0d, 0x1b, 0xe4, 0xda, 0xf5, 0xbd, 0x28, 0x62, 0xc9, 0x40, 0x0d,
+    0x09, 0xa7, 0xf9, 0x52, 0x50, 0xfa, 0x2b, 0xa4, 0xbf, 0x02, 0xe6, 0x73, 0x61, 0x68, 0x0d, 0x7b,
+    0x13, 0xc8, 0x63, 0x50, 0x17, 0xc7, 0x5f, 0xbe, 0xb6, 0xff, 0x78, 0xf7, 0x4a, 0x8e, 0x8b, 0xce,
+    0xf1, 0xd1, 0xb9, 0x8c, 0xa8, 0x83, 0xd1, 0x36, 0x06, 0x00, 0x70, 0xc4, 0x39, 0x3a, 0xb7, 0x9d,
+    0x79, 0xd1, 0xb1, 0x73, 0x2a, 0x5b, 0xca, 0x6d, 0xbc, 0xcb, 0x73, 0x0c, 0x62, 0x2b, 0xcd, 0x4f,
+    0xa5, 0xc6, 0x6c, 0x52, 0x95, 0xa2, 0x25, 0x37, 0x48, 0x45, 0xa5, 0x54, 0x61, 0xcb, 0x06, 0xa9,
+    0x7b, 0x16, 0xac, 0x49, 0x41, 0xd7, 0x94, 0xf4, 0xe6, 0x06, 0x6f, 0x9c, 0x31, 0x5f, 0xad, 0x9e,
+    0xef, 0x64, 0xb4, 0x44, 0xd2, 0xaa, 0x61, 0x29, 0x0d, 0x7c, 0x12, 0x41, 0xa5, 0x12, 0x98, 0x16,
+    0x17, 0x2e, 0x01, 0x43, 0x3a, 0x8d, 0x42, 0xc3, 0x10, 0xca, 0xb5, 0x06, 0xb7, 0xbe, 0xa7, 0xc3,
+    0x48, 0x24, 0xae, 0xa5, 0x15, 0x84, 0x74, 0x81, 0x9a, 0xdd, 0x5a, 0x8d, 0xce, 0xc3, 0x1b, 0x8d,
+    0x8e, 0xe6, 0x4a, 0x9b, 0x93, 0x30, 0x35, 0x4a, 0x2b, 0xd4, 0x14, 0x83, 0x84, 0xce, 0x66, 0xbb,
+    0xb5, 0x8e, 0x53, 0xff, 0xaf, 0xfe, 0x44, 0xdd, 0xc4, 0x73, 0xb5, 0x69, 0x89, 0x75, 0xa8, 0xa3,
+    0x4a, 0xc0, 0x46, 0x8d, 0x74, 0x4c, 0x3c, 0xf3, 0x03, 0x95, 0x3a, 0x94, 0x4c, 0x7e, 0x14, 0x62,
+    0xe6, 0xb9, 0x03, 0xe5, 0x39, 0xfd, 0xcd, 0xc1, 0xf5, 0xa2, 0xe1, 0x8e, 0x1e, 0x7d, 0x90, 0x66,
+    0x50, 0xd6, 0xd1, 0xa4, 0x71, 0xb6, 0x3e, 0x1c, 0xd2, 0x70, 0x38, 0xc4, 0x45, 0x43, 0x07, 0x95,
+    0x27, 0xd9, 0xc3, 0x5d, 0x27, 0xae, 0xfb, 0x6e, 0x24, 0xee, 0x3b, 0x33, 0xb4, 0x66, 0x59, 0xc5,
+    0x3f, 0xbd, 0x0a, 0x5c, 0x11, 0x96, 0x88, 0x8e, 0x64, 0xee, 0x31, 0x25, 0x29, 0x2e, 0x27, 0xea,
+    0xfc, 0x6c, 0x3c, 0x46, 0xde, 0x2c, 0x16, 0xa7, 0x6e, 0xea, 0x27, 0x71, 0x14, 0x9d, 0xa8, 0xb1,
+    0xa1, 0x40, 0xb7, 0xdc, 0x6f, 0x8f, 0xb9, 0xfd, 0x78, 0xca, 0x3b, 0x28, 0x32, 0xb4, 0x3b, 0x51,
+    0xe6, 0x15, 0x55, 0x2d, 0xb8, 0x0f, 0x5e, 0xdb, 0x7d, 0xfc, 0x81, 0x0a, 0x8a, 0x11, 0xe8, 0x84,
+    0x70, 0x9a, 0xd5, 0x11, 0xe2, 0xc6, 0x98, 0x72, 0xf1, 0x10, 0x75, 0x94, 0x30, 0x9d, 0x64, 0xb9,
+    0x06, 0xb3, 0xe4, 0x1f, 0x72, 0x76, 0xd7, 0x82, 0x3f, 0x52, 0x04, 0x2a, 0x8e, 0x22, 0x75, 0x83,
+    0x86, 0x03, 0x68, 0x50, 0xf9, 0xe9, 0xee, 0x0a, 0x49, 0xcc, 0x23, 0x90, 0x35, 0x04, 0x45, 0xd3,
+    0x44, 0xd1, 0x29, 0xbc, 0x51, 0x63, 0x6f, 0x16, 0x61, 0xe9, 0x2a, 0xa8, 0x96, 0x65, 0x58, 0xb6,
+    0xdf, 0x87, 0xdb, 0x8e, 0x71, 0x43, 0x8d, 0xc3, 0xfa, 0x2b, 0x1c, 0x99, 0x40, 0x04, 0x45, 0xf7,
+    0x58, 0x85, 0x93, 0xc0, 0x2c, 0x3b, 0x10, 0xd0, 0x6e, 0x6c, 0x77, 0x5b, 0x48, 0x14, 0xfd, 0x5c,
+    0xa4, 0x54, 0x7f, 0x5b, 0x89, 0xee, 0xab, 0xc5, 0x82, 0x51, 0xdd, 0xda, 0x33, 0x9d, 0xb5, 0x08,
+    0x3b, 0x22, 0x99, 0xab, 0x6a, 0xf5, 0xfa, 0xe5, 0x51, 0x11, 0x69, 0x67, 0x25, 0xb0, 0xb4, 0x07,
+    0x05, 0x67, 0x03, 0x33, 0xe4, 0x50, 0x45, 0x2d, 0x80, 0x09, 0xb8, 0xcb, 0x14, 0xf5, 0x51, 0xec,
+    0x64, 0x3c, 0x2e, 0xa8, 0xa1, 0xa4, 0xd1, 0x62, 0x87, 0x77, 0xa8, 0xd3, 0x39, 0x2b, 0x95, 0x9f,
+    0xaf, 0x95, 0x9e, 0x15, 0xd5, 0x23, 0x15, 0x29, 0xa3, 0xb6, 0xec, 0x64, 0x3d, 0xa4, 0xa9, 0xc5,
+    0x1a, 0x19, 0x9d, 0x11, 0xa5, 0xa2, 0x8b, 0xc2, 0x4a, 0xdc, 0x49, 0xdb, 0xb9, 0x5d, 0xc5, 0xbd,
+    0xb4, 0xd3, 0xc5, 0x20, 0x19, 0xc6, 0x33, 0x06, 0xac, 0xc1, 0x51, 0xe5, 0x94, 0xeb, 0x4d, 0xa7,
+    0xd1, 0x3d, 0xdb, 0x81, 0x19, 0x5d, 0x15, 0xa1, 0x1e, 0x29, 0x32, 0x29, 0x24, 0xa4, 0xb4, 0x7a,
+    0xac, 0x64, 0xb8, 0x26, 0x59, 0x68, 0x2e, 0x0d, 0x78, 0x95, 0xed, 0x04, 0x27, 0xec, 0x04, 0x0e,
+    0xd5, 0xff, 0x8b, 0xc5, 0x05, 0x73, 0xfc, 0xc0, 0xd3, 0x13, 0xd5, 0x09, 0x1c, 0xf0, 0x04, 0xf1,
+    0xd2, 0xf9, 0x13, 0x26, 0x86, 0x88, 0xbb, 0x1a, 0xa0, 0x5e, 0xa9, 0xf7, 0x0f, 0xb6, 0x72, 0x4f,
+    0x3f, 0x0f, 0xb7, 0x4f, 0xf1, 0x48, 0x95, 0x02, 0x5f, 0xa9, 0x90, 0xab, 0x60, 0x50, 0x58, 0x56,
+    0x49, 0xc6, 0x35, 0x5e, 0x82, 0x80, 0x47, 0x70, 0x53, 0x38, 0xa1, 0x26, 0xbe, 0xc7, 0x55, 0x91,
+    0x72, 0xa2, 0xbb, 0xaa, 0xc7, 0xbe, 0x32, 0xbb, 0x2c, 0x54, 0xaa, 0x04, 0x45, 0x4b, 0x67, 0x07,
+    0xd7, 0x67, 0xb8, 0x16, 0x91, 0x71, 0xa9, 0x0c, 0xe5, 0xe7, 0x7b, 0x2e, 0xc6, 0x6c, 0xf0, 0x9e,
+    0x2a, 0x4d, 0xba, 0xde, 0x38, 0xef, 0xfe, 0x70, 0x53, 0x73, 0x1f, 0x29, 0xf7, 0xd2, 0xf3, 0xaf,
+    0x27, 0xf6, 0x35, 0xf0, 0x3a, 0x8e, 0x62, 0xe0, 0x05, 0xee, 0x7f, 0x46, 0xb5, 0xd7, 0x55, 0x8c,
+    0x4a, 0xd3, 0x11, 0x0e, 0xaf, 0x39, 0xdc, 0x11, 0x47, 0xa4, 0xe2, 0x6e, 0xed, 0xc1, 0x30, 0x2b,
+    0x57, 0xf0, 0x71, 0x2b, 0x7c, 0x16, 0x78, 0xc7, 0xdc, 0x8b, 0xa6, 0x38, 0xe1, 0x5d, 0x5a, 0x48,
+    0xb2, 0x93, 0xba, 0xe6, 0x8d, 0x13, 0xf1, 0x36, 0x5f, 0x09, 0xa9, 0x29, 0x75, 0xfd, 0x4d, 0xa3,
+    0x5d, 0x73, 0xa6, 0x77, 0x80, 0xa0, 0x35, 0x65, 0x93, 0x52, 0xd9, 0x88, 0xfd, 0x10, 0xb6, 0x96,
+    0xf0, 0x99, 0x76, 0xef, 0xa0, 0xf0, 0x8a, 0x8a, 0x02, 0xea, 0x90, 0xf6, 0x33, 0xd2, 0xde, 0x1a,
+    0x4a, 0xbc, 0x20, 0xae, 0xea, 0x8a, 0x37, 0xae, 0xc4, 0x7b, 0xdc, 0xdf, 0x92, 0x9d, 0xd5, 0x13,
+    0xde, 0x38, 0x13, 0x1f, 0xf2, 0xc5, 0x12, 0xca, 0x20, 0x09, 0x89, 0xba, 0xd1, 0xc5, 0x8a, 0x1f,
+    0x2a, 0x86, 0x24, 0x75, 0xad, 0x37, 0x5b, 0x72, 0x49, 0x96, 0xfc, 0x89, 0x12, 0x91, 0xf6, 0x27,
+    0x70, 0x85, 0x0f, 0x22, 0xec, 0x7d, 0x28, 0x3e, 0x22, 0x39, 0xe0, 0xf2, 0x51, 0xe2, 0x4d, 0x28,
+    0x2a, 0xe2, 0xec, 0xe0, 0xa9, 0x9b, 0x75, 0x5e, 0x31, 0x27, 0x1b, 0x46, 0xe6, 0xfc, 0x8d, 0xe9,
+    0x93, 0xf5, 0xe9, 0xbf, 0x57, 0xa6, 0x53, 0xdc, 0x6c, 0x9a, 0x9f, 0x8f, 0x43, 0xc1, 0x47, 0x5c,
+    0x06, 0xbf, 0xcb, 0x66, 0x69, 0xd5, 0xcd, 0xc6, 0xd8, 0xf8, 0xb3, 0x87, 0x35, 0x3b, 0x76, 0x5e,
+    0x92, 0x2d, 0x24, 0x76, 0xe8, 0x0d, 0xf1, 0x24, 0x66, 0x08, 0xf0, 0xd1, 0xf6, 0xb3, 0xb1, 0x3e,
+    0x8d, 0xf5, 0xbb, 0x78, 0x77, 0xc5, 0xbd, 0x18, 0xa6, 0xc2, 0x8e, 0x14, 0x4e, 0xe9, 0x38, 0x35,
+    0x0a, 0x48, 0x91, 0x77, 0x1d, 0xa2, 0x5f, 0xd9, 0x18, 0xe5, 0x1d, 0x04, 0xf3, 0xee, 0xae, 0x87,
+    0x04, 0xd8, 0x6e, 0x61, 0x42, 0x11, 0x6e, 0x60, 0x37, 0x89, 0x2d, 0xfe, 0x84, 0xbd, 0x7f, 0x57,
+    0xed, 0xbd, 0x26, 0x7b, 0x3f, 0xca, 0x16, 0x38, 0x2d, 0x41, 0x2e, 0xb5, 0xc1, 0x93, 0xa9, 0xf6,
+    0x12, 0x53, 0xf1, 0xa0, 0xed, 0x3f, 0x72, 0xe1, 0x1a, 0x86, 0xf1, 0x87, 0xdf, 0xa1, 0xe3, 0xef,
+    0xcd, 0x7a, 0x2a, 0xae, 0x5c, 0x57, 0x94, 0x33, 0x96, 0xa8, 0x8a, 0x18, 0x0b, 0x16, 0x8b, 0x64,
+    0xb1, 0x78, 0xcd, 0x09, 0x08, 0x14, 0x22, 0x9d, 0xea, 0x37, 0xd6, 0x87, 0xb3, 0xdc, 0x79, 0x98,
+    0x86, 0x97, 0x91, 0x92, 0xdb, 0x78, 0xff, 0x28, 0x2d, 0x8f, 0x31, 0xea, 0xde, 0x8a, 0x24, 0xa7,
+    0x02, 0x5b, 0x17, 0x9f, 0xa3, 0xf3, 0x83, 0x8b, 0x53, 0x34, 0x1f, 0xb8, 0x38, 0x41, 0xf3, 0x19,
+    0x2c, 0x71, 0x25, 0xcf, 0x21, 0x7a, 0x86, 0x6f, 0x20, 0xde, 0x60, 0xf0, 0x2d, 0x0d, 0x1a, 0x2d,
+    0x4f, 0x31, 0xaa, 0xa9, 0x09, 0x28, 0x53, 0xfb, 0x79, 0xd0, 0xd1, 0x0d, 0x25, 0xfb, 0x95, 0x08,
+    0x74, 0xea, 0xff, 0xc6, 0x1f, 0xc5, 0x5f, 0xe1, 0xd6, 0x29, 0xf3, 0xf0, 0x6e, 0x0a, 0xc9, 0x2c,
+    0x1f, 0xaf, 0x2c, 0xa3, 0x64, 0xa5, 0x1e, 0xcc, 0x91, 0xe4, 0x2b, 0xea, 0x5a, 0x0b, 0x38, 0x56,
+    0xc0, 0x81, 0x2c, 0xd0, 0xd4, 0x1d, 0xa9, 0xd4, 0x24, 0xf1, 0xfd, 0x06, 0xf9, 0x42, 0xf7, 0xbc,
+    0xd4, 0x9d, 0x1f, 0xdd, 0x11, 0xdb, 0xce, 0x54, 0xe5, 0x93, 0xad, 0x2e, 0xde, 0x79, 0x07, 0xd6,
+    0xcb, 0xaa, 0xa2, 0xf7, 0xf2, 0x96, 0xe2, 0x2a, 0xc6, 0x78, 0x35, 0x93, 0x4f, 0x28, 0x93, 0xeb,
+    0x27, 0x7b, 0x35, 0xca, 0xf5, 0xf5, 0xfc, 0x2a, 0x72, 0x8f, 0x32, 0xaf, 0x7e, 0x45, 0x12, 0xad,
+    0xe1, 0xd3, 0x0c, 0x3c, 0xb3, 0x19, 0x58, 0x3f, 0x23, 0x7e, 0x3b, 0xe3, 0x2f, 0x73, 0xeb, 0x36,
+    0xec, 0xc3, 0xc6, 0x1f, 0xc3, 0x37, 0x2f, 0x87, 0x36, 0x1d, 0x21, 0xb6, 0x33, 0x67, 0x9f, 0xc4,
+    0x67, 0x71, 0x9d, 0x11, 0x3f, 0xc4, 0x17, 0x22, 0xfe, 0xc2, 0xf5, 0x72, 0x49, 0xc4, 0x37, 0x10,
+    0x37, 0x44, 0xfc, 0x14, 0x46, 0xbc, 0xcb, 0x00, 0x14, 0xab, 0x65, 0x4e, 0x7c, 0x49, 0x95, 0x04,
+    0x62, 0x65, 0x5a, 0x68, 0x98, 0x16, 0x1a, 0xa6, 0x85, 0x86, 0x69, 0xa1, 0x61, 0x9a, 0x6b, 0xa8,
+    0xc4, 0xe9, 0xbb, 0xd2, 0xd4, 0x1d, 0x77, 0x6c, 0xa1, 0x98, 0x42, 0xe7, 0x35, 0xea, 0x96, 0xcb,
+    0x78, 0x74, 0x8f, 0xe0, 0xd1, 0xee, 0x28, 0xf6, 0x67, 0x37, 0x65, 0xd1, 0x21, 0x76, 0xa4, 0x09,
+    0xc2, 0x14, 0x01, 0x45, 0xa5, 0x29, 0xc2, 0x69, 0xbb, 0x25, 0xec, 0xed, 0xd8, 0x87, 0x6c, 0x76,
+    0xbe, 0xb9, 0x24, 0xce, 0x28, 0x9c, 0xc3, 0xcc, 0x4f, 0x79, 0x65, 0x67, 0x23, 0x7d, 0xeb, 0x26,
+    0x9e, 0xa5, 0x6a, 0x14, 0xdf, 0x6a, 0x47, 0xfc, 0x95, 0x33, 0xc8, 0x33, 0xd9, 0x38, 0x51, 0x8e,
+    0xf8, 0x56, 0x94, 0x82, 0x7a, 0x94, 0x0d, 0xcf, 0x90, 0xd5, 0x3f, 0xa5, 0x13, 0x27, 0x54, 0x3f,
+    0x79, 0x64, 0x79, 0x76, 0x73, 0x6d, 0x25, 0x2a, 0x0d, 0x7f, 0x2a, 0x87, 0xee, 0xdb, 0x6d, 0xb6,
+    0xb3, 0x55, 0xbc, 0x7a, 0xe2, 0xf1, 0xd6, 0xc9, 0xea, 0x36, 0xd6, 0xea, 0x76, 0xeb, 0x84, 0x2a,
+    0x67, 0xde, 0x3d, 0xc1, 0xab, 0x64, 0x90, 0xba, 0xe1, 0x68, 0xb1, 0x48, 0x5d, 0xed, 0xdd, 0xc0,
+    0x73, 0x33, 0x46, 0x83, 0x7c, 0x28, 0x77, 0x50, 0x4a, 0x78, 0x05, 0x5a, 0x34, 0xe1, 0x52, 0x4f,
+    0x7e, 0xa2, 0x70, 0x3b, 0xc9, 0x9e, 0x25, 0x2c, 0xa5, 0x4a, 0xee, 0xa5, 0xc1, 0xc3, 0xfe, 0x72,
+    0x66, 0x14, 0xf6, 0xe6, 0x19, 0xaf, 0xee, 0xd3, 0xe5, 0xe3, 0x70, 0x52, 0x37, 0xf7, 0xa2, 0x19,
+    0xf4, 0xe5, 0x2f, 0x31, 0x80, 0x4b, 0xdf, 0xf5, 0x23, 0x2f, 0x4d, 0x3f, 0x61, 0x19, 0x94, 0xb0,
+    0x24, 0x58, 0x9f, 0x86, 0xfe, 0x35, 0x6e, 0x3e, 0xb0, 0xb2, 0x9a, 0xaa, 0x7f, 0x7a, 0x22, 0x7f,
+    0x3b, 0x80, 0x97, 0xb6, 0xac, 0xe8, 0xba, 0x18, 0x94, 0x63, 0xb3, 0x21, 0xe4, 0x9c, 0xc3, 0x83,
+    0x74, 0xea, 0xe9, 0x8d, 0x42, 0x01, 0x98, 0xe1, 0xe1, 0x41, 0x83, 0xfe, 0x49, 0xe8, 0x7f, 0x88,
+    0x02, 0x5b, 0x1e, 0xcb, 0x36, 0xb0, 0xf6, 0xe1, 0x6f, 0x16, 0x2e, 0x5e, 0x02, 0x0d, 0xfa, 0x83,
+    0x9b, 0xa1, 0xeb, 0x53, 0x8c, 0xe2, 0xda, 0x17, 0x94, 0x42, 0xc5, 0x76, 0xc4, 0x67, 0xf9, 0x86,
+    0xae, 0xe1, 0x1f, 0x68, 0xf0, 0xfa, 0x7c, 0x2b, 0x3f, 0x43, 0x54, 0x7c, 0x90, 0x3f, 0xa8, 0xc9,
+    0x61, 0xbf, 0x80, 0x53, 0x42, 0x93, 0x26, 0x61, 0x49, 0x93, 0xb0, 0xa9, 0x49, 0xb0, 0xd4, 0x2c,
+    0xaf, 0x94, 0x6e, 0x15, 0x12, 0x9e, 0xbc, 0x1d, 0x4d, 0x21, 0x55, 0x82, 0x05, 0xdd, 0xaa, 0x04,
+    0xd8, 0x86, 0x1e, 0x8d, 0x94, 0x39, 0xe3, 0x6a, 0xaa, 0xad, 0x5e, 0x0f, 0xf4, 0x03, 0x01, 0xee,
+    0x90, 0x63, 0x76, 0x4a, 0x3f, 0x3a, 0x29, 0xf7, 0xb6, 0x1e, 0x02, 0xd1, 0x3c, 0x50, 0x41, 0xfd,
+    0xd4, 0xcd, 0x9e, 0x10, 0x59, 0x85, 0x2a, 0xc6, 0xf6, 0x61, 0x20, 0x22, 0x34, 0x29, 0xa7, 0xd8,
+    0x81, 0xc1, 0x91, 0x1b, 0xd5, 0xc6, 0x78, 0x1e, 0x68, 0x22, 0x0d, 0x48, 0x53, 0x3b, 0x06, 0x17,
+    0xd8, 0x18, 0x63, 0x0d, 0x14, 0x72, 0x9a, 0x7e, 0xde, 0xa0, 0x9f, 0x60, 0xb4, 0xb4, 0xa4, 0xa0,
+    0xa1, 0x96, 0x1d, 0xd2, 0x34, 0x04, 0xd2, 0xd6, 0x73, 0xd6, 0x1c, 0x3c, 0x95, 0xa1, 0x6b, 0x8a,
+    0xaf, 0x11, 0x73, 0xa2, 0x6b, 0x64, 0x90, 0xd2, 0xf5, 0x99, 0x18, 0xd1, 0x60, 0x8d, 0xac, 0x4a,
+    0x74, 0xdd, 0xeb, 0x1a, 0x2a, 0x43, 0x8c, 0x16, 0x81, 0x98, 0xf3, 0xc3, 0x43, 0xeb, 0x36, 0xd4,
+    0x0c, 0x5a, 0x4c, 0xc5, 0x88, 0xfa, 0xcb, 0x55, 0x29, 0x56, 0xc1, 0x63, 0xa3, 0x33, 0x5c, 0xaa,
+    0xe2, 0xb2, 0xce, 0xc7, 0xe0, 0xb7, 0x71, 0x01, 0x0e, 0x3b, 0x2e, 0xaa, 0xf2, 0x4d, 0x4f, 0x4d,
+    0x5b, 0xf7, 0x32, 0x2a, 0xdc, 0xec, 0x6f, 0x4a, 0x45, 0x88, 0xe3, 0xf5, 0x29, 0xa8, 0x1e, 0xb7,
+    0xa8, 0x82, 0xaa, 0xf7, 0x16, 0x70, 0x00, 0x25, 0x93, 0xcd, 0x4a, 0xa8, 0xba, 0xb7, 0x6b, 0xc4,
+    0xb3, 0xc4, 0xa7, 0x5f, 0x3a, 0x69, 0xb9, 0x68, 0x2c, 0xfb, 0x6b, 0xe0, 0x86, 0x0e, 0x8e, 0xfe,
+    0x0b, 0x35, 0xe3, 0xb1, 0x3c, 0xb7, 0xc7, 0x97, 0x28, 0x79, 0x01, 0x22, 0x88, 0xe3, 0xeb, 0x54,
+    0x9e, 0x11, 0x7a, 0x52, 0x41, 0xb8, 0x69, 0x8d, 0xaf, 0xf6, 0xdc, 0x2b, 0x35, 0xa3, 0xdd, 0xd6,
+    0x92, 0x2f, 0xd9, 0x6d, 0xa8, 0x01, 0x22, 0xa2, 0x00, 0x27, 0xe1, 0xbc, 0xfe, 0xec, 0xf0, 0xee,
+    0x7f, 0x01, 0x81, 0x40, 0x11, 0x6e, 0x34, 0x17, 0x00, 0x00,
+};
+
+// cp.min.css: 2752 bytes, 739 gzip'd
+static const char     k_CpCssType[]     = "text/css";
+static const char     k_CpCssEtag[]     = "\"c49911b77d6f6f4c\"";
+static const uint8    k_CpCssGz[] PROGMEM =
+{
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x56, 0x8d, 0x92, 0x9a, 0x30,
+    0x10, 0x7e, 0x15, 0xe6, 0x6e, 0x9c, 0xd1, 0x96, 0xd0, 0x70, 0xd6, 0xf6, 0x1a, 0x9e, 0x26, 0x40,
+    0x80, 0x8c, 0x31, 0x61, 0x42, 0xd0, 0xeb, 0x39, 0xf7, 0xee, 0xdd, 0x04, 0xa2, 0x20, 0xe0, 0xb5,
+    0xd3, 0x51, 0x07, 0x5d, 0x76, 0x37, 0xf9, 0xb2, 0x3f, 0xdf, 0x42, 0x94, 0x29, 0xa1, 0x34, 0xaa,
+    0x79, 0xb6, 0x67, 0x3a, 0x8c, 0x86, 0x77, 0xc1, 0x97, 0x9b, 0x7b, 0x42, 0x68, 0x61, 0x26, 0x5e,
+    0x84, 0xa4, 0xac, 0x50, 0x9a, 0x8d, 0xd5, 0xb3, 0xbe, 0xde, 0xf5, 0x8c, 0x4e, 0x2c, 0xdd, 0x73,
+    0x83, 0x52, 0xf5, 0x86, 0x1a, 0xfe, 0xce, 0x65, 0x49, 0x52, 0xa5, 0x73, 0xa6, 0xad, 0x26, 0x41,
+    0x07, 0xf5, 0xbe, 0x60, 0x9a, 0xd5, 0x7e, 0x8c, 0x40, 0xce, 0xb5, 0x6a, 0xb8, 0xe1, 0x4a, 0x12,
+    0x9a, 0x36, 0x4a, 0xb4, 0x86, 0x25, 0x46, 0xd5, 0x04, 0x27, 0x82, 0x15, 0x06, 0xfe, 0xde, 0x11,
+    0x97, 0x39, 0x7b, 0x23, 0xbf, 0xe0, 0x33, 0x5e, 0x89, 0x32, 0x25, 0x0d, 0xe5, 0x12, 0xf6, 0x48,
+    0x69, 0xb6, 0x2f, 0xb5, 0x6a, 0x65, 0x4e, 0x9e, 0x31, 0xc6, 0x89, 0x73, 0xeb, 0xc4, 0x9a, 0xe6,
+    0xb9, 0xc5, 0x8f, 0x6b, 0x38, 0xe9, 0x30, 0x8e, 0x8a, 0xe6, 0xea, 0x64, 0xd5, 0xc1, 0x0e, 0xae,
+    0x18, 0xc3, 0x8f, 0x2e, 0x53, 0xba, 0xc6, 0xa1, 0xfd, 0x46, 0xbb, 0xcd, 0x20, 0xb0, 0xcf, 0x7d,
+    0xff, 0xd2, 0xed, 0xc4, 0x73, 0x53, 0x91, 0x8c, 0x8a, 0x6c, 0x1d, 0xc7, 0xd1, 0x8e, 0x1d, 0x82,
+    0xaf, 0xc1, 0xb6, 0x7e, 0xdb, 0x2c, 0x45, 0x76, 0x5b, 0xd4, 0x81, 0x65, 0xb6, 0x64, 0x23, 0x7b,
+    0x5f, 0xbd, 0x3e, 0xf3, 0x5d, 0x4e, 0xb8, 0xac, 0x98, 0xe6, 0x66, 0x09, 0xaf, 0xdf, 0xf4, 0x6c,
+    0x15, 0x4c, 0x1a, 0xf2, 0xf4, 0x94, 0xe4, 0xbc, 0xa9, 0x05, 0xfd, 0x4d, 0x0c, 0x4d, 0x05, 0x4b,
+    0x32, 0xc1, 0xa8, 0x86, 0x62, 0x9a, 0x6a, 0xbc, 0x45, 0xc0, 0xcf, 0x05, 0xac, 0xf1, 0xfb, 0x27,
+    0xf6, 0xc6, 0x96, 0x9e, 0x91, 0xf8, 0xa5, 0xbe, 0x29, 0x39, 0xaa, 0xae, 0x45, 0xd7, 0x4c, 0x50,
+    0xc3, 0x8f, 0xac, 0xcf, 0x8c, 0xcb, 0x49, 0x52, 0x31, 0x5e, 0x56, 0x86, 0xc4, 0x18, 0xe4, 0x42,
+    0x28, 0x6a, 0x88, 0xb6, 0x8a, 0x24, 0x6b, 0x75, 0x03, 0x31, 0xc8, 0x06, 0x69, 0x66, 0xf7, 0x4e,
+    0x06, 0x75, 0x6f, 0xb5, 0x58, 0x8f, 0x41, 0xa2, 0x5a, 0x96, 0x9b, 0x1d, 0x5e, 0x05, 0xf6, 0x92,
+    0x0a, 0xd6, 0xd4, 0x8c, 0x9a, 0xe1, 0x1a, 0xdf, 0x0f, 0x02, 0x42, 0xa7, 0x1a, 0x95, 0x9a, 0xe6,
+    0x1c, 0xa2, 0x5e, 0x1b, 0x15, 0x40, 0x0f, 0x86, 0x9a, 0xe5, 0x01, 0x0e, 0x9f, 0x8b, 0x02, 0x07,
+    0xf1, 0xcf, 0x55, 0xf8, 0x8c, 0x41, 0xd8, 0x6e, 0x9d, 0x50, 0xd8, 0x4d, 0x41, 0xc0, 0x45, 0xf0,
+    0xc3, 0x9a, 0x0a, 0x10, 0x5e, 0xc1, 0x64, 0x97, 0xc4, 0x18, 0xaf, 0x3c, 0xee, 0x37, 0x7b, 0xe3,
+    0x34, 0xb3, 0x27, 0x40, 0xfc, 0x40, 0x4b, 0x46, 0x5c, 0xa3, 0x3d, 0xe0, 0x10, 0x53, 0xa4, 0x47,
+    0x80, 0x5c, 0x58, 0x75, 0x05, 0xeb, 0x0a, 0xef, 0x43, 0xef, 0x89, 0xb4, 0x68, 0x56, 0x47, 0xa6,
+    0xa1, 0xcc, 0x27, 0x52, 0xf1, 0x3c, 0x67, 0xf2, 0xb6, 0x59, 0xa0, 0xb5, 0xe6, 0x67, 0x04, 0x8a,
+    0x5e, 0x6c, 0xb7, 0xb8, 0xde, 0x98, 0x0e, 0x8c, 0xed, 0xa5, 0x73, 0x53, 0xa1, 0xb2, 0xbd, 0x6f,
+    0x2a, 0xdb, 0x60, 0x53, 0x84, 0x0b, 0x59, 0x06, 0x8d, 0xbf, 0x34, 0x98, 0x3c, 0x1e, 0x90, 0xc0,
+    0xa8, 0xc3, 0x15, 0x78, 0x0c, 0xd7, 0xb1, 0x8e, 0xb8, 0x23, 0x06, 0xb0, 0x9e, 0xe7, 0xc9, 0x88,
+    0x88, 0x46, 0x53, 0xd9, 0xd4, 0x54, 0x03, 0x98, 0x37, 0xb8, 0x8d, 0xc7, 0x3c, 0xf5, 0x26, 0x0b,
+    0x71, 0x97, 0xc1, 0xcd, 0x71, 0x99, 0x53, 0x78, 0x96, 0x52, 0x76, 0xcb, 0xe4, 0x40, 0x75, 0xc9,
+    0x65, 0x87, 0xec, 0x46, 0xe4, 0x3d, 0x46, 0x35, 0xc7, 0x4f, 0x29, 0xe5, 0x1b, 0xfa, 0x3e, 0xb1,
+    0xec, 0x60, 0x0e, 0x07, 0x93, 0x11, 0x6f, 0x36, 0xe1, 0x8c, 0xab, 0x3b, 0x95, 0xed, 0xca, 0xa2,
+    0x73, 0x7e, 0xd9, 0xed, 0x42, 0x7f, 0xc1, 0x92, 0x7f, 0xe3, 0xd1, 0xa3, 0x30, 0x1f, 0x0b, 0xf7,
+    0xdf, 0xdc, 0x5a, 0xb6, 0xf4, 0xc3, 0x34, 0xd3, 0xaa, 0x81, 0x07, 0x17, 0xd7, 0x93, 0x86, 0xba,
+    0xc3, 0xbb, 0xef, 0x17, 0xda, 0x75, 0xf2, 0x12, 0xe7, 0xba, 0x06, 0x8c, 0x5e, 0xaf, 0x0d, 0x68,
+    0xe5, 0x19, 0xa4, 0xf9, 0x87, 0x59, 0x67, 0x79, 0x10, 0x33, 0xed, 0x63, 0x7a, 0x86, 0x97, 0x9e,
+    0x78, 0xd7, 0x77, 0x85, 0x8e, 0x9b, 0x50, 0xb3, 0xb6, 0x21, 0x83, 0x94, 0x4f, 0xf5, 0x53, 0xd5,
+    0xc7, 0x9d, 0x78, 0x5c, 0x26, 0x2d, 0xe5, 0xfa, 0x44, 0x3a, 0xf6, 0x75, 0x07, 0x77, 0xb2, 0x3b,
+    0x7b, 0xaf, 0x1d, 0x9c, 0xcf, 0xf6, 0xca, 0xed, 0xfc, 0x9a, 0xa4, 0xed, 0xf2, 0xc6, 0x66, 0x54,
+    0x9b, 0x55, 0x08, 0xde, 0x37, 0x84, 0x6a, 0x0d, 0x91, 0x4a, 0xb2, 0x4b, 0x60, 0x6d, 0x63, 0x5d,
+    0x99, 0x60, 0x99, 0x37, 0xd8, 0xb0, 0x66, 0xb4, 0xcd, 0x54, 0x39, 0xf5, 0xf2, 0x78, 0xb4, 0x46,
+    0x15, 0xc4, 0x23, 0x06, 0xa3, 0x6c, 0x30, 0xe9, 0x3e, 0xfe, 0x00, 0xd1, 0xdf, 0x78, 0x5e, 0xc0,
+    0x0a, 0x00, 0x00,
+};
@@ -14,14 +14,59 @@
 #include "TimeZone.h"
 #include "Console.h"
 
+#define MAX_SLEW_MS         30000       // slewing 30s at 5% takes 10 minutes
+
 
 const char    WebServer::k_daysOfWeek3[] = "Sun\0Mon\0Tue\0Wed\0Thu\0Fri\0Sat";
 
 
+// sorted by uri (strcmp order.  upper case before lower case).  in flash, read with the _P functions
+WebServer::Route const  WebServer::g_routes[] PROGMEM =
+{
+    "",             & WebServer::OnRoot,
+    "BNtp",         & WebServer::OnSyncNtp,                 // buttons
+    "DOnOff",       & WebServer::OnDimOnOff,                // forms
+    "Date",         & WebServer::OnShowDate,
+    "MicroAdjust",  & WebServer::OnMicroAdjust,
+    "NTP",          & WebServer::OnNtp,
+    "QHr",          & WebServer::OnQuarterOfHour,
+    "SDOnOff",      & WebServer::OnSetDimOnOff,
+    "SDate",        & WebServer::OnSetShowDate,
+    "SMicroAdjust", & WebServer::OnSetMicroAdjust,
+    "SNTP",         & WebServer::OnSetNtp,
+    "SPopup",       & WebServer::OnSetPopup,
+    "SQHr",         & WebServer::OnSetQuarterOfHour,
+    "SSettings",    & WebServer::OnSetSettings,
+    "STOnOff",      & WebServer::OnSetTimeOnOff,
+    "STimeZone",    & WebServer::OnSetTimeZone,
+    "STopHr",       & WebServer::OnSetTopOfHour,
+    "SWebReq",      & WebServer::OnSetWebReq,
+    "Settings",     & WebServer::OnSettings,
+    "Sp",           & WebServer::OnSetPassword,
+    "TOnOff",       & WebServer::OnTimeOnOff,
+    "TestPopup",    & WebServer::OnCreatePopup,
+    "TimeZone",     & WebServer::OnTimeZone,
+    "TopHr",        & WebServer::OnTopOfHour,
+    "WebReq",       & WebServer::OnWebReq,
+    "about",        & WebServer::OnAbout,                   // misc
+    "cp.css",       & WebServer::OnColorPickerMinCss,
+    "cp.js",        & WebServer::OnColorPickerMinJs,
+    "forcedim",     & WebServer::OnForceDim,                // actions
+    "forceon",      & WebServer::OnForceOn,
+    "p",            & WebServer::OnGetPassword,
+    "popup",        & WebServer::OnPopup,
+    "r2",           & WebServer::OnRoot2,
+    "stats",        & WebServer::OnStats,
+    "time",         & WebServer::OnTime,
+};
+
+
 WebServer::WebServer()
     : _responses            ( 0 )
+    , _minFreeHeap          ( UINT32_MAX )
+    , _apPageCount          ( 0 )
     , _snappedOptions       ( nullptr )
-    , _buffer               ( [this](char const *txt){ _content += txt; } )
+    , _buffer               ( [this](char const *txt){ OnFlush( txt ); } )
 {
 }
 
@@ -33,95 +78,125 @@ WebServer::ResponsesSent() const
 }
 
 
+uint32
+WebServer::MinFreeHeap() const
+{
+    return _minFreeHeap;
+}
+
+
+Histogram const &
+WebServer::Latency() const
+{
+    return _latency;
+}
+
+
 void
 WebServer::on( char const *uri, THandlerFunction handler )
 {
-    on( uri, true, handler );
+    if ( _apPageCount < k_maxApPages )
+    {
+        _apUri[ _apPageCount ] = uri;
+        _apHandler[ _apPageCount ] = handler;
+        _apPageCount += 1;
+    }
 }
 
 
 void
-WebServer::on( char const *uri, bool sta, THandlerFunction handler )
+WebServer::begin()
 {
+    const uint32    freeHeap    = ESP.getFreeHeap();
+
+    // the table is searched with a binary search
+    for ( uint index = 1; index < countof(g_routes); ++index )
+    {
+        char    uri[ sizeof(Route::_uri) ];
+
+        strncpy_P( uri, g_routes[ index ]._uri, sizeof(uri) );
+        if ( strcmp_P( uri, g_routes[ index - 1 ]._uri ) <= 0 )
+        {
+            Out( "WebServer: route '%s' is out of order\n", uri );
+        }
+    }
+
     WiFi.scanNetworksAsync( nullptr );
 
-    ESP8266WebServer::on( 
-        PrintF( "/%s", uri ),
-        [this, sta, handler]()
-        {           
-            const bool    isLocal = ( this->client().localIP() == WiFi.localIP() );
+    // every request goes through OnRequest()
+    ESP8266WebServer::onNotFound( [this]() { OnRequest(); } );
 
-            Out( "WebServer: '%s'\n", this->uri().c_str() );
-            ResetPageState();
+    static const char * headerkeys[] = { "Cookie", "If-None-Match" };
+    ESP8266WebServer::collectHeaders( headerkeys, countof(headerkeys) );
+    ESP8266WebServer::begin();
 
-            if ( sta != isLocal )
-            {
-                OnNotFound();
-            }
-           
-            handler();
-            SendPage();
-        } );
+    Out( "WebServer: %d routes, %d bytes of heap\n", countof(g_routes), freeHeap - ESP.getFreeHeap() );
 }
 
 
 void
-WebServer::begin()
+WebServer::OnRequest()
 {
-    // todo - could save some ram here 
-
-    on( "",             std::bind( &WebServer::OnRoot, this ) );
-    on( "r2",           std::bind( &WebServer::OnRoot2, this ) );
-    on( "p",            std::bind( &WebServer::OnGetPassword, this ) );
-    on( "Sp",           std::bind( &WebServer::OnSetPassword, this ) );
-
-    // forms
-    on( "Settings",     std::bind( &WebServer::OnSettings, this ) );
-    on( "SSettings",    std::bind( &WebServer::OnSetSettings, this ) );
-    on( "TOnOff",       std::bind( &WebServer::OnTimeOnOff, this ) );
-    on( "STOnOff",      std::bind( &WebServer::OnSetTimeOnOff, this ) );
-    on( "DOnOff",       std::bind( &WebServer::OnDimOnOff, this ) );
-    on( "SDOnOff",      std::bind( &WebServer::OnSetDimOnOff, this ) );
-
-    on( "TopHr",        std::bind( &WebServer::OnTopOfHour, this ) );
-    on( "STopHr",       std::bind( &WebServer::OnSetTopOfHour, this ) );
-    on( "QHr",          std::bind( &WebServer::OnQuarterOfHour, this ) );
-    on( "SQHr",         std::bind( &WebServer::OnSetQuarterOfHour, this ) );
-    on( "Date",         std::bind( &WebServer::OnShowDate, this ) );
-    on( "SDate",        std::bind( &WebServer::OnSetShowDate, this ) );
-
-    on( "NTP",          std::bind( &WebServer::OnNtp, this ) );
-    on( "SNTP",         std::bind( &WebServer::OnSetNtp, this ) );
-    on( "TimeZone",     std::bind( &WebServer::OnTimeZone, this ) );
-    on( "STimeZone",    std::bind( &WebServer::OnSetTimeZone, this ) );
-    on( "MicroAdjust",  std::bind( &WebServer::OnMicroAdjust, this ) );
-    on( "SMicroAdjust", std::bind( &WebServer::OnSetMicroAdjust, this ) );
-    on( "WebReq",       std::bind( &WebServer::OnWebReq, this ) );
-    on( "SWebReq",      std::bind( &WebServer::OnSetWebReq, this ) );
-    
-    // buttons
-    on( "BNtp",         std::bind( &WebServer::OnSyncNtp, this ) );
-    on( "TestPopup",    std::bind( &WebServer::OnCreatePopup, this ) );
-    on( "SPopup",       std::bind( &WebServer::OnSetPopup, this ) );
-    
-    on( "cp.css",       std::bind( &WebServer::OnColorPickerMinCss, this ) );
-    on( "cp.js",        std::bind( &WebServer::OnColorPickerMinJs, this ) );
-    
-    // actions
-    on( "popup",        std::bind( &WebServer::OnPopup, this ) );
-    on( "forcedim",     std::bind( &WebServer::OnForceDim, this ) );
-    on( "forceon",      std::bind( &WebServer::OnForceOn, this ) );
-    on( "time",         std::bind( &WebServer::OnTime, this ) );
-
-    // misc
-    on( "stats",        std::bind( &WebServer::OnStats, this ) );
-    on( "about",        std::bind( &WebServer::OnAbout, this ) );
-    
-    ESP8266WebServer::onNotFound ( std::bind( &WebServer::OnNotFound, this ) );
+    const String      & path    = this->uri();
+    char const        * uri     = path.c_str() + 1;     // skip the '/'
+    const bool          isLocal = ( client().localIP() == WiFi.localIP() );
+    int                 low     = 0;
+    int                 high    = ( isLocal ? countof( g_routes ) - 1 : -1 );
+    void                ( WebServer::* handler )() = nullptr;
+    THandlerFunction  * apPage  = nullptr;
 
-    static const char * headerkeys[] = { "Cookie" };
-    ESP8266WebServer::collectHeaders( headerkeys, countof(headerkeys) );
-    ESP8266WebServer::begin();
+    // the access point's pages are only served on the access point.  the rest only on the station
+    for ( uint index = 0; (!isLocal) && (index < _apPageCount); ++index )
+    {
+        if ( strcmp( uri, _apUri[ index ] ) == 0 )
+        {
+            apPage = &_apHandler[ index ];
+        }
+    }
+
+    while ( low <= high )
+    {
+        const int   mid     = ( low + high ) / 2;
+        const int   cmp     = strcmp_P( uri, g_routes[ mid ]._uri );
+
+        if ( cmp == 0 )
+        {
+            memcpy_P( &handler, &g_routes[ mid ]._handler, sizeof(handler) );
+            break;
+        }
+
+        if ( cmp < 0 )
+        {
+            high = mid - 1;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+
+    if ( (!handler) && (!apPage) )
+    {
+        OnNotFound();
+        return;
+    }
+
+    Out( "WebServer: '%s'\n", path.c_str() );
+    ResetPageState();
+
+    const uint32  start   = micros();
+
+    if ( handler )
+    {
+        (this->*handler)();
+    }
+    else
+    {
+        (*apPage)();
+    }
+    _minFreeHeap = MIN( _minFreeHeap, ESP.getFreeHeap() );
+    SendPage();
+    _latency.Push( micros() - start );
 }
 
 
@@ -195,13 +270,13 @@ WebServer::OnNotFound()
     }
     else
     {
-        _content = PrintF( "File Not Found\n\nURI: %s", uri().c_str() );  
+        const String    content = PrintF( "File Not Found\n\nURI: %s", uri().c_str() );  
 
         SendHeader( "Cache-Control", "no-cache, no-store, must-revalidate" );
         SendHeader( "Pragma", "no-cache" );
         SendHeader( "Expires", "-1" );
-        SendHeader( "Content-Length", String( _content.length()) );
-        Send ( 404, "text/plain", _content );
+        SendHeader( "Content-Length", String( content.length()) );
+        Send ( 404, "text/plain", content );
     }
 
     g_globalColor.PingState( GlobalColor::ClientRequest );
@@ -212,7 +287,8 @@ void
 WebServer::ResetPageState()
 {
     _responseSent   = false;
-    _content        = "";
+    _streaming      = false;
+    _lastFlush      = false;
     _titleScale     = 0;
     _formStarted    = false;
     _divStarted     = false;
@@ -571,6 +647,7 @@ WebServer::AddColorEffect( ARGB argb )
     case ARGB::BlendInOut:      effect = "Blend In %s Blend Out";   break;
     case ARGB::BlendOut:        effect = "Appear %s Blend Out";     break;
     case ARGB::Flash:           effect = "Flash %s";                break;
+    case ARGB::Pulse:           effect = "Pulse %s";                break;
     default:                    effect = "? %s";                    break;
     }
 
@@ -596,7 +673,7 @@ WebServer::AddColorEffect( ARGB argb )
 void
 WebServer::AddColorEffectEdit( ARGB argb )
 {
-    static char const * names[]     = { "Appear", "Cross Fade", "Blend In & Out", "Appear & Blend Out", "Flash", "Disabled" };
+    static char const * names[]     = { "Appear", "Cross Fade", "Blend In & Out", "Appear & Blend Out", "Flash", "Pulse", "Disabled" };
     const uint          effect      = (argb.alpha & ARGB::EffectMask) >> 4;     // now matches the table above
  
     // D() - return document element by id
@@ -613,7 +690,7 @@ WebServer::AddColorEffectEdit( ARGB argb )
             "h=D('e');"
             "if(h.value==4){a='flash';b='times';}else{a='hold for';b='seconds';}"
             "S('aa',a);S('ab',b);"
-            "v=(h==5?'hidden':'visible');"
+            "v=(h==6?'hidden':'visible');"
           //"V('aa',v);V('ab',v);V('z',v);"
             "}"
         "</script>"
@@ -624,7 +701,7 @@ WebServer::AddColorEffectEdit( ARGB argb )
     // aa, ab, az - misc text
     // c - color
     Add( "Effect Type:<select id='e' name='e' onchange='LX()'>" );
-    _selectionValue = ( argb.alpha ? effect : 5 );
+    _selectionValue = ( argb.alpha ? effect : 6 );
     for( uint index=0; index < countof(names); ++index )
     {
         AddOption( index, names[ index ] );
@@ -656,7 +733,7 @@ WebServer::GetColorEffect()
     ARGB            argb            = ARGB::FromString( arg('c') );
 
     argb.alpha = ( effectValue << 4 ) | hold;
-    if ( effectValue == 5 )
+    if ( effectValue == 6 )
     {
         // disabled == appear for 0 time 
         argb.alpha = 0;
@@ -672,7 +749,7 @@ WebServer::SendPage()
     { 
         if ( memcmp(_snappedOptions, &g_options, sizeof(g_options)) )
         { 
-            g_options.Save();
+            g_options.SaveSoon();
         }
 
         delete _snappedOptions;
@@ -680,25 +757,32 @@ WebServer::SendPage()
 
         Redirect( _snapRedir );
     }
-    else if ( !_isText )
+    else
     {
-        EndDiv();
-        EndForm();
-        
-        if ( _titleScale )
+        if ( !_isText )
         {
-            Add( "</body></html>" );
+            EndDiv();
+            EndForm();
+        
+            if ( _titleScale )
+            {
+                Add( "</body></html>" );
+            }
         }
 
+        _lastFlush = true;
         _buffer.Flush();
-        SendHeader( "Content-Length", String( _content.length() ) );
-        Send( 200, "text/html", _content );
-    }
-    else
-    {
-        _buffer.Flush();
-        SendHeader( "Content-Length", String( _content.length() ) );
-        Send( 200, "text/plain", _content );
+
+        if ( _streaming )
+        {
+            // end of chunks
+            ESP8266WebServer::sendContent( "" );
+        }
+        else
+        {
+            // empty page (skipped if already sent)
+            Send( 200, ContentType(), "" );
+        }
     }
 
     if ( _pingColorState )
@@ -708,6 +792,43 @@ WebServer::SendPage()
 }
 
 
+char const *
+WebServer::ContentType() const
+{
+    return ( _isText ? "text/plain" : "text/html" );
+}
+
+
+// The page is built in _buffer.  If it all fits it's sent with a Content-Length, otherwise 
+// the response is started on the first flush and each flush is sent as a chunk.  This keeps
+// the ram used per request to the size of _buffer no matter how large the page is.
+void
+WebServer::OnFlush( char const *txt )
+{
+    if ( !_streaming )
+    {
+        if ( _responseSent )
+        {
+            // redirected.  drop the page
+            return;
+        }
+
+        if ( _lastFlush )
+        {
+            SendHeader( "Content-Length", String( strlen(txt) ) );
+            Send( 200, ContentType(), txt );
+            return;
+        }
+
+        ESP8266WebServer::setContentLength( CONTENT_LENGTH_UNKNOWN );
+        Send( 200, ContentType(), "" );
+        _streaming = true;
+    }
+
+    ESP8266WebServer::sendContent( txt );
+}
+
+
 void 
 WebServer::SendHeader( char const *name, const String &value )
 {
@@ -744,6 +865,18 @@ WebServer::Send( int code, char const * contentType, char const *content )
 }
 
 
+void 
+WebServer::Send( int code, char const * contentType, uint8 const *content, uint length )
+{
+    if ( !_responseSent )
+    {
+        ESP8266WebServer::send_P( code, contentType, (PGM_P) content, length );
+        _responseSent = true;
+        _responses += 1;
+    }
+}
+
+
 void
 WebServer::SnapOptions( const char *redir )
 {
@@ -987,9 +1120,7 @@ WebServer::OnRoot2()
         AddLinkDiv( "MicroAdjust" );            // link.. enable/disable.  smoothing data.  history data
         if ( g_options._madjEnable )
         {
-            int32   madj = g_options._madjFreq * g_options._madjDir;
-    
-            AddF_br( "%s seconds per day", MadjSecondsPerDay( madj ).c_str() );
+            AddF_br( "%s seconds per day", MadjSecondsPerDay( g_options._madjPpb ).c_str() );
             AddF_br( "Last adjust: %s", LastMicroAdjust().c_str() );
         }
         else
@@ -1069,8 +1200,9 @@ WebServer::OnSetSettings()
 void
 WebServer::OnTimeOnOff()
 {
+    CheckClient();          // before any output.  the page streams once the buffer fills
     SetTitle( "Display Time" );
-    AddClientForm( "TOnOff" );
+    AddForm( "TOnOff" );
 
     // 0=on time, 1=off time, 2,3,4,5,6,7,8,9 = sun-sat
     AddOnOffEdit( '0', "On between", g_options._timeOnOff );
@@ -1088,8 +1220,9 @@ WebServer::OnSetTimeOnOff()
 void
 WebServer::OnDimOnOff()
 {
+    CheckClient();          // before any output.  the page streams once the buffer fills
     SetTitle( "Dimming Times" );
-    AddClientForm( "DOnOff" );
+    AddForm( "DOnOff" );
 
     // 0=on time, 1=off time, 2,3,4,5,6,7,8,9 = sun-sat
     AddOnOffEdit( '0', "Dim between", g_options._dimOnOff );
@@ -1107,8 +1240,9 @@ WebServer::OnSetDimOnOff()
 void
 WebServer::OnTopOfHour()
 {
+    CheckClient();          // before any output.  the page streams once the buffer fills
     SetTitle( "Top Of Hour" );
-    AddClientForm( "TopHr" );
+    AddForm( "TopHr" );
     AddColorEffectEdit( g_options._topOfHour );
 }
 
@@ -1124,8 +1258,9 @@ WebServer::OnSetTopOfHour()
 void
 WebServer::OnQuarterOfHour()
 {
+    CheckClient();          // before any output.  the page streams once the buffer fills
     SetTitle( "Quarter Of Hour" );
-    AddClientForm( "QHr" );
+    AddForm( "QHr" );
     AddColorEffectEdit( g_options._quarterOfHour );
 }
 
@@ -1183,7 +1318,7 @@ WebServer::OnNtp()
     // e - highlight errors
     // (e,h,z - in AddColorEffectEdit)
 
-    AddInput_br     ( 's', sizeof(g_options._ntpServer), g_options._ntpServer, "NTP Server: " );
+    AddInput_br     ( 's', sizeof(g_options._ntpServer), g_options._ntpServer, "NTP Servers: " );
 
     AddTime( 't', "Sync at ", g_options._ntpSync );
     AddF( " every <select name='f'>" );
@@ -1280,13 +1415,14 @@ WebServer::OnSetTimeZone()
 void
 WebServer::OnMicroAdjust()
 {
-    const int32  madj0 = g_options._madjFreq * g_options._madjDir;
-
     AddClientForm( "MicroAdjust" );
 
     // todo.. make manual allow setting of time
     AddCheckbox_br  ( 'e', "Enable", g_options._madjEnable );
-    AddF_br( "Adjust %s seocnds per day (%dms per %d)", MadjSecondsPerDay(madj0).c_str(), g_options._madjDir, g_options._madjFreq );
+    AddF_br( "Slew offsets up to <input min='0' max='%d' size='5' value='%d' name='b'/> ms (larger ones step the time)", MAX_SLEW_MS, g_options._slewMaxMs );
+    AddF_br( "Adjust %s seconds per day (%dppb%s)", MadjSecondsPerDay(g_options._madjPpb).c_str(), g_options._madjPpb, MadjIsLocked() ? ", locked" : "" );
+    AddF_br( "Discipline: %s", DisciplineStr().c_str() );
+    AddF_br( "Locked after boot: %s", TimeToLock().c_str() );
     EndForm();
     AddF_br( "Log:" );
     LogToHtml( [this]( char const *txt ) { Add( txt ); } );
@@ -1299,14 +1435,16 @@ WebServer::OnSetMicroAdjust()
 {
     SnapOptions( "/r2" );
     g_options._madjEnable = !!arg( 'e' ).length();
+    g_options._slewMaxMs  = constrain( arg( 'b' ).toInt(), 0, MAX_SLEW_MS );
 }
 
 
 void       
 WebServer::OnWebReq()
 {
+    CheckClient();          // before any output.  the page streams once the buffer fills
     SetTitle( "Web Request" );
-    AddClientForm( "WebReq" );
+    AddForm( "WebReq" );
 
     // 
     Add( "<font color='#191970'>Web request effect:</font><br>" );
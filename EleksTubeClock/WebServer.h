@@ -9,13 +9,24 @@
 
 class WebServer : public ESP8266WebServer
 {
+public:
+    // pages.  g_routes is sorted by _uri (without the leading '/').  it's in flash (PROGMEM)
+    struct Route
+    {
+        char const          _uri[ 13 ];
+        void                ( WebServer::* const _handler )();
+    };
+
+    static const uint   k_maxApPages    = 4;
+
 public:
     WebServer();
 
     uint32              ResponsesSent() const;
+    uint32              MinFreeHeap() const;
+    Histogram const   & Latency() const;
 
-    void                on( char const *uri, THandlerFunction handler );
-    void                on( char const *uri, bool ap, THandlerFunction handler );
+    void                on( char const *uri, THandlerFunction handler );    // a page served on the access point
     void                begin();
     String              arg( char name );
 
@@ -65,14 +76,19 @@ private:
     static String       ColoredText( ARGB rgb, char const *text );
 
 private:
+    char const        * ContentType() const;
+    void                OnFlush( char const *txt );
     void                SendHeader( char const *name, const String &value );
     void                SendHeader( char const *name, const char *value ); 
     void                Send( int code, char const * contentType, const String& content );
     void                Send( int code, char const * contentType, char const *content );
+    void                Send( int code, char const * contentType, uint8 const *content, uint length );
+    void                SendAsset( char const *contentType, char const *etag, uint8 const *gz, uint length );
     void                Redirect( String const &uri, bool sendSessionId );
     void                Redirect( char const *uri );
     void                Redirect( char const *uri, bool sendSessionId );
 
+    void                OnRequest();
     void                OnNotFound();
     void                EndDiv();
 
@@ -117,21 +133,28 @@ private:
     void                OnSetPopup();
 
 private:
+    static Route const  g_routes[];
     static const char   k_daysOfWeek3[];
 
 private:
     uint                _responses;                 // misc stat
+    uint32              _minFreeHeap;               // lowest free heap seen at the end of a page handler
+    Histogram           _latency;                   // us to handle & send each request
     uint32              _clientId;                  // if login required
+    uint8               _apPageCount;
+    char const        * _apUri[ k_maxApPages ];     // access point pages (the rest are in g_routes)
+    THandlerFunction    _apHandler[ k_maxApPages ];
                      
     // per-request
-    StringBuffer        _buffer;                    // place to build some output before reallocating the content string
+    StringBuffer        _buffer;                    // place to build some output before sending it to the client
     bool                _responseSent;              // only send 1 response per request
+    bool                _streaming;                 // headers sent.  each _buffer flush is sent as a chunk
+    bool                _lastFlush;                 // SendPage() is flushing the end of the page
     bool                _pingColorState;            // ping g_globalColor that a web request arrived
     uint8               _titleScale;                // non-zero if title has been set
     bool                _formStarted;               // true if a form was started (and </form> is needed)
     bool                _divStarted;                
-    bool                _isText;                    // _content is a text response
-    String              _content;                   // the response (right now is 1 big string?)
+    bool                _isText;                    // the response is text/plain (set before adding any content)
     Options           * _snappedOptions;            // if processing a form, this is the before state of the options
     char const        * _snapRedir;                 // if processing a form, this is the page to redirect the client too
     uint                _selectionValue;            // used for making selection values easier
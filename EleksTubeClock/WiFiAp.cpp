@@ -24,9 +24,9 @@ WiFiAp::Setup()
 
     _dnsServer.setErrorReplyCode( DNSReplyCode::NoError );
 
-    _server.on( "c",        false, std::bind( &WiFiAp::OnRoot, this ) );
-    _server.on( "SConnect", false, std::bind( &WiFiAp::OnConnect, this ) );
-    _server.on( "Scan",     false, std::bind( &WiFiAp::OnScan, this ) );
+    _server.on( "c",        [this]() { OnRoot(); } );
+    _server.on( "SConnect", [this]() { OnConnect(); } );
+    _server.on( "Scan",     [this]() { OnScan(); } );
     _server.begin(); 
 
     UpdateNextTime();
@@ -173,10 +173,6 @@ WiFiAp::UpdateWiFiStatus()
         if ( popup )
         {
             Popup1x6( popup, color );
-            if ( g_options._dirty )
-            {
-                g_options.Save();
-            }
         }
 
         _status = status;
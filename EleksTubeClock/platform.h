@@ -14,6 +14,11 @@
 #include <TimeLib.h>            // https://github.com/PaulStoffregen/Time
 
 #define NEOLED_PIN              14      // D5
+#define NEOLED_PIN2             0       // 12      // D6    second strip (0 == one strip).  the digits are split between the strips
+#ifndef LED_UART1
+#define LED_UART1               0       // 1: drive the leds from UART1's TX (GPIO2, D4) instead of bit-banging NEOLED_PIN.  see Uart1Leds.h
+#endif
+#define STATUS_LED              ( LED_UART1 ? 0 : BUILTIN_LED )     // flashes each second (0 == none.  GPIO2 is the led data with LED_UART1)
 #define FLASH_BUTTON_PIN        0      
 #define GPIO_FORCE_TIMEON       0       // 5       // D1    (0 == disabled)
 #define GPIO_FORCE_TIMEOFF      0       // 4       // D2
@@ -23,7 +28,18 @@
 #define FASTLED_INTERNAL        // remove various compile time debug output
 #include <FastLED.h>            // https://github.com/FastLED/FastLED
 
-#define NUM_DIGITS  6
+#ifndef NUM_DIGITS
+#define NUM_DIGITS          6                   // 4 (hh mm), 6 (hh mm ss) or 8 (hh mm ss and 2 blank)
+#endif
+#define POSITIONS_PER_DIGIT 10                  // the 0-9 glyphs of a tube
+#define LEDS_PER_POSITION   2                   // a glyph is lit by this many leds.  POSITIONS_PER_DIGIT apart
+#define LEDS_PER_DIGIT      ( POSITIONS_PER_DIGIT * LEDS_PER_POSITION )
+#define NUM_LEDS            ( NUM_DIGITS * LEDS_PER_DIGIT )
+#define STRIP1_LEDS         ( (NEOLED_PIN2 ? NUM_DIGITS / 2 : NUM_DIGITS) * LEDS_PER_DIGIT )
+#define APPROX_FPS          60
+#define MS_PER_FRAME        (1000 / APPROX_FPS)  
+#define MS_PER_IDLE_FRAME   250                 // frame interval when the display is static
+#define SECOND_GUARD_MS     8                   // hold off other work this close to a second boundary
 
 // simple types
 using   int8    = int8_t;
@@ -38,7 +54,7 @@ using   uint    = unsigned int;
 
 // simple macros
 #define countof(a)  ( (int) ( sizeof(a)/sizeof(a[0]) ) )
-#define ABS(a)      ( ((a) < 0) ? (-a) : (a) )
+#define ABS(a)      ( ((a) < 0) ? (-(a)) : (a) )
 #define MAX(a,b)    ( (a) > (b) ? (a) : (b) )
 #define MIN(a,b)    ( (a) < (b) ? (a) : (b) )
 #define Out         ets_printf
@@ -55,25 +71,35 @@ using   uint    = unsigned int;
 #include "TimeOnOff.h"
 #include "DimOnOff.h"
 #include "Smooth.h"
+#include "Histogram.h"
+#include "JsonScan.h"
 #include "Options.h"
 #include "GlobalColor.h"
 #include "EleksDigit.h"
+#include "FrameTimer.h"
 
 
 // globals
 extern EleksDigit   g_digits[];
-extern uint64       g_frameCount;           // number of frames (at 60fps)
+extern uint64       g_frameCount;           // number of frames (up to APPROX_FPS)
 extern uint64       g_frameOff;             // number of frames skipped due to being off
+extern uint64       g_frameSame;            // number of frames skipped due to no change
 extern uint32       g_framesLag;            // number of times a frame was late / laggy
+extern uint32       g_fps;                  // effective frames per second (last second)
+extern uint32       g_idlePercent;          // share of the last second spent sleeping
+extern Histogram    g_secondPhase;          // how late (us) the digits changed after the gmt second
 extern bool         g_wifiIsConnected;
 extern uint8        g_brightness;
 
 extern void         OutC( char c );
 extern void         OutStr( char const *str );
+extern void         NextFrame();
 extern void         ShowLeds();
 extern void         PrintTime();
 extern void         OutNl();
 extern void         UpdateWaitTimes();
+extern bool         DisplayIsIdle();        // the display is static (so the frames have slowed down)
+extern void         Reboot();               // flush pending changes and restart
 extern String       TimeStr();
 
 extern void         Popup( String const &str, ARGB color );
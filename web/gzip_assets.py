@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+#
+# gzip_assets.py
+#  Regenerates EleksTubeClock/WebAssets.h from the static web files in this directory.
+#  The files are stored gzip'd in flash and served with "Content-Encoding: gzip" and an
+#  ETag of the content hash.  Run after editing any of the files below.
+#
+# Author: Ken Reneris <https://github.com/KenReneris>
+# MIT License
+# ----------------------------------------------------------
+
+import gzip
+import hashlib
+import os
+
+ASSETS = [
+    # name,     file,           content type
+    ( "CpJs",   "cp.min.js",    "application/javascript" ),
+    ( "CpCss",  "cp.min.css",   "text/css" ),
+]
+
+here = os.path.dirname( os.path.abspath(__file__) )
+out = os.path.join( here, "..", "EleksTubeClock", "WebAssets.h" )
+
+with open( out, "w", newline="\n" ) as f:
+    f.write( "/*\n" )
+    f.write( " * WebAssets.h\n" )
+    f.write( " *  Generated by web/gzip_assets.py.  Do not edit.\n" )
+    f.write( " *\n" )
+    f.write( " * Author: Ken Reneris <https://github.com/KenReneris>\n" )
+    f.write( " * MIT License\n" )
+    f.write( " * ----------------------------------------------------------\n" )
+    f.write( " */\n\n" )
+
+    for name, file, contentType in ASSETS:
+        data = open( os.path.join(here, file), "rb" ).read()
+        gz = gzip.compress( data, compresslevel=9, mtime=0 )
+        etag = hashlib.sha1( data ).hexdigest()[ :16 ]
+
+        f.write( "\n// %s: %d bytes, %d gzip'd\n" % (file, len(data), len(gz)) )
+        f.write( "static const char     k_%sType[]     = \"%s\";\n" % (name, contentType) )
+        f.write( "static const char     k_%sEtag[]     = \"\\\"%s\\\"\";\n" % (name, etag) )
+        f.write( "static const uint8    k_%sGz[] PROGMEM =\n{\n" % name )
+        for pos in range( 0, len(gz), 16 ):
+            f.write( "    " + " ".join( "0x%02x," % b for b in gz[pos:pos+16] ) + "\n" )
+        f.write( "};\n" )